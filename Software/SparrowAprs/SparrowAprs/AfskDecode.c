@@ -1,4 +1,4 @@
-#include <math.h>
-#include <stdint.h>
-#include <complex.h>
-#include "AfskDefs.h"
+#include <math.h>
+#include <stdint.h>
+#include <complex.h>
+#include "AfskDefs.h"
@@ -0,0 +1,358 @@
+/*
+	Altimeter
+
+	GPS altitude arrives once a second at best, and disappears altogether when
+	the receiver drops its fix or sleeps. The BME280 gives pressure ten times a
+	second, through any of that, but pressure altitude is only as good as the
+	standard atmosphere and drifts with the weather.
+
+	A three state Kalman filter puts the two together:
+
+		h	altitude, metres
+		v	vertical speed, metres per second
+		b	barometric bias, how far pressure altitude reads above h
+
+	Pressure updates h + b, GPS updates h, and the bias walks slowly so a GPS
+	outage leaves us flying on the barometer with the last known offset.
+	Everything is scalar updates on a 3x3 covariance, same cost every step.
+
+	This task is the only thing that talks to the BME280, everyone else gets
+	the last reading from here.
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <math.h>
+#include <string.h>
+#include "Bme280Shim.h"
+#include "GpsHub.h"
+#include "Crash.h"
+#include "Altimeter.h"
+
+// Sample period, the BME280 is set up for a new reading about this often
+#define SAMPLE_PERIOD			100
+
+// Vertical acceleration noise, m/s^2 squared per second
+// Burst takes us from +5 to -30m/s in a few seconds, the filter has to keep up
+#define ACCEL_NOISE				4.0f
+
+// Bias drift, m^2 per second
+// Standard atmosphere error grows as we climb, a few percent of altitude
+#define BIAS_NOISE				1.0f
+
+// Pressure noise in Pa, turned into metres for the altitude we're at
+#define PRESSURE_NOISE			2.0f
+
+// GPS vertical error, m^2
+#define GPS_VARIANCE			64.0f
+
+// GPS altitudes further out than this many sigma are ignored
+// A run of them means we're the ones who are wrong, take the next one
+#define GPS_GATE_SIGMA2			25.0f
+#define GPS_GATE_REJECTS		10
+
+// Starting uncertainty
+#define INITIAL_ALTITUDE_VAR	10000.0f
+#define INITIAL_SPEED_VAR		25.0f
+#define INITIAL_BIAS_VAR		10000.0f
+
+// Climbing faster than this for long enough means we've been launched
+#define LAUNCH_SPEED			1.0f
+#define LAUNCH_CONFIRM			30000
+
+// Falling faster than this for long enough after launch means the balloon has gone
+#define BURST_SPEED				-5.0f
+#define BURST_CONFIRM			5000
+
+// Standard atmosphere
+#define ISA_P0					101325.0f
+#define ISA_T0					288.15f
+#define ISA_P11					22632.1f
+#define ISA_T11					216.65f
+#define ISA_P20					5474.89f
+#define ISA_RG					29.2712f
+
+typedef struct
+{
+	float X[3];
+	float P[3][3];
+} VerticalFilterT;
+
+static VerticalFilterT filter;
+static uint8_t filterRunning = 0;
+
+static TickType_t climbSince;
+static TickType_t fallSince;
+static uint8_t climbing = 0;
+static uint8_t falling = 0;
+static uint8_t launched = 0;
+static uint8_t gpsRejects = 0;
+
+// Published to other tasks under a critical section
+static AltimeterStateT state;
+
+static void AltimeterTask(void* pvParameters);
+static TaskHandle_t altimeterTaskHandle = NULL;
+
+void AltimeterInit(void)
+{
+	memset(&state, 0, sizeof(state));
+}
+
+void AltimeterStartTask(void)
+{
+	// Create task
+	xTaskCreate(AltimeterTask,
+		"Altimeter",
+		300,
+		NULL,
+		4,
+		&altimeterTaskHandle);
+}
+
+void AltimeterGetState(AltimeterStateT* s)
+{
+	taskENTER_CRITICAL();
+	*s = state;
+	taskEXIT_CRITICAL();
+}
+
+// Standard atmosphere altitude for a pressure in Pa, good to 32km
+// Also gives the temperature there, for the metres per Pa
+static float PressureAltitude(const float pressure, float* temperature)
+{
+	if (pressure > ISA_P11)
+	{
+		*temperature = ISA_T0 * powf(pressure / ISA_P0, 0.190263f);
+		return (ISA_T0 - *temperature) / 0.0065f;
+	}
+	else if (pressure > ISA_P20)
+	{
+		*temperature = ISA_T11;
+		return 11000.0f + ISA_RG * ISA_T11 * logf(ISA_P11 / pressure);
+	}
+	else
+	{
+		*temperature = ISA_T11 * powf(pressure / ISA_P20, -0.0292712f);
+		return 20000.0f + (*temperature - ISA_T11) / 0.001f;
+	}
+}
+
+static void FilterReset(const float altitude)
+{
+	memset(&filter, 0, sizeof(filter));
+
+	filter.X[0] = altitude;
+	filter.P[0][0] = INITIAL_ALTITUDE_VAR;
+	filter.P[1][1] = INITIAL_SPEED_VAR;
+	filter.P[2][2] = INITIAL_BIAS_VAR;
+}
+
+// Constant velocity model driven by white acceleration noise, bias a random walk
+static void FilterPredict(const float dt)
+{
+	float (*P)[3] = filter.P;
+	float dt2 = dt * dt;
+	float p01;
+
+	filter.X[0] += filter.X[1] * dt;
+
+	// P = F P F', F moves velocity into altitude
+	p01 = P[0][1] + P[1][1] * dt;
+	P[0][0] += (P[0][1] + P[1][0]) * dt + P[1][1] * dt2;
+	P[0][1] = p01;
+	P[1][0] = p01;
+	P[0][2] += P[1][2] * dt;
+	P[2][0] = P[0][2];
+
+	// + Q
+	P[0][0] += ACCEL_NOISE * dt2 * dt / 3.0f;
+	P[0][1] += ACCEL_NOISE * dt2 / 2.0f;
+	P[1][0] += ACCEL_NOISE * dt2 / 2.0f;
+	P[1][1] += ACCEL_NOISE * dt;
+	P[2][2] += BIAS_NOISE * dt;
+}
+
+// Scalar measurement z = H x, H is 1 on altitude and optionally on bias
+// Returns 0 if the gate threw it out
+static uint8_t FilterUpdate(const float z, const uint8_t withBias, const float r, const float gate)
+{
+	float (*P)[3] = filter.P;
+	float ph[3];
+	float k[3];
+	float innovation;
+	float s;
+	uint32_t i;
+	uint32_t j;
+
+	// P H'
+	for (i = 0; i < 3; i++)
+	{
+		ph[i] = P[i][0] + (withBias ? P[i][2] : 0);
+	}
+
+	s = ph[0] + (withBias ? ph[2] : 0) + r;
+	innovation = z - filter.X[0] - (withBias ? filter.X[2] : 0);
+
+	if (gate != 0 && innovation * innovation > gate * s)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		k[i] = ph[i] / s;
+		filter.X[i] += k[i] * innovation;
+	}
+
+	// P -= K H P, symmetric so H P is ph'
+	for (i = 0; i < 3; i++)
+	{
+		for (j = 0; j < 3; j++)
+		{
+			P[i][j] -= k[i] * ph[j];
+		}
+	}
+
+	return 1;
+}
+
+// Launch and burst, from vertical speed held for a while
+static void TrackFlight(const TickType_t timeNow, const float speed)
+{
+	if (speed > LAUNCH_SPEED)
+	{
+		if (!climbing)
+		{
+			climbing = 1;
+			climbSince = timeNow;
+		}
+
+		if (timeNow - climbSince > LAUNCH_CONFIRM)
+		{
+			launched = 1;
+		}
+	}
+	else
+	{
+		climbing = 0;
+	}
+
+	if (speed < BURST_SPEED)
+	{
+		if (!falling)
+		{
+			falling = 1;
+			fallSince = timeNow;
+		}
+
+		if (launched && !state.Burst && timeNow - fallSince > BURST_CONFIRM)
+		{
+			state.Burst = 1;
+			CrashTrace(CRASH_TRACE_BURST, (uint16_t)(filter.X[0] / 10.0f));
+		}
+	}
+	else
+	{
+		falling = 0;
+	}
+}
+
+static void AltimeterTask(void* pvParameters)
+{
+	TickType_t lastTaskTime = xTaskGetTickCount();
+	TickType_t lastStep = lastTaskTime;
+	TickType_t timeNow;
+	SituationInfoT situation;
+	uint32_t lastSequence = 0;
+	float temperature;
+	float pressure;
+	float humidity;
+	float altitude;
+	float isaTemperature;
+	float metresPerPa;
+	float dt;
+	uint8_t haveBaro;
+	uint8_t haveGps;
+
+	while (1)
+	{
+		vTaskDelayUntil(&lastTaskTime, SAMPLE_PERIOD);
+		timeNow = xTaskGetTickCount();
+
+		haveBaro = Bme280ShimGetTph(&temperature, &pressure, &humidity) && pressure > 0;
+
+		// Only a fix we haven't used yet, with an altitude in it
+		haveGps = GpsHubGetSituation(&situation)
+			&& situation.Sequence != lastSequence
+			&& situation.AltitudeValid;
+		lastSequence = situation.Sequence;
+
+		if (!filterRunning)
+		{
+			if (!haveBaro && !haveGps)
+			{
+				continue;
+			}
+
+			FilterReset(haveGps ? situation.Altitude : PressureAltitude(pressure, &isaTemperature));
+			filterRunning = 1;
+			lastStep = timeNow;
+		}
+
+		dt = (timeNow - lastStep) / 1000.0f;
+		lastStep = timeNow;
+
+		if (dt > 0)
+		{
+			FilterPredict(dt);
+		}
+
+		if (haveBaro)
+		{
+			// Metres per Pa grows as the air thins, and so does the noise in metres
+			altitude = PressureAltitude(pressure, &isaTemperature);
+			metresPerPa = ISA_RG * isaTemperature / pressure;
+			FilterUpdate(altitude, 1, PRESSURE_NOISE * PRESSURE_NOISE * metresPerPa * metresPerPa, 0);
+		}
+
+		if (haveGps)
+		{
+			// The fix is from a little while ago, bring it up to now
+			altitude = situation.Altitude + filter.X[1] * (timeNow - situation.Timestamp) / 1000.0f;
+
+			if (FilterUpdate(altitude, 0, GPS_VARIANCE, gpsRejects < GPS_GATE_REJECTS ? GPS_GATE_SIGMA2 : 0))
+			{
+				gpsRejects = 0;
+			}
+			else
+			{
+				gpsRejects++;
+			}
+		}
+
+		taskENTER_CRITICAL();
+		state.Valid = 1;
+		state.Timestamp = timeNow;
+		state.Altitude = filter.X[0];
+		state.VerticalSpeed = filter.X[1];
+
+		if (haveGps)
+		{
+			state.LastGps = timeNow;
+			state.GpsAided = 1;
+		}
+
+		if (haveBaro)
+		{
+			state.BaroValid = 1;
+			state.Temperature = temperature;
+			state.Pressure = pressure;
+			state.Humidity = humidity;
+		}
+
+		TrackFlight(timeNow, filter.X[1]);
+		taskEXIT_CRITICAL();
+	}
+}
@@ -0,0 +1,26 @@
+#ifndef ALTIMETER_H
+#define ALTIMETER_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+typedef struct
+{
+	uint8_t Valid;
+	uint8_t GpsAided;
+	uint8_t BaroValid;
+	uint8_t Burst;
+	TickType_t Timestamp;
+	TickType_t LastGps;
+	float Altitude;
+	float VerticalSpeed;
+	float Temperature;
+	float Pressure;
+	float Humidity;
+} AltimeterStateT;
+
+void AltimeterInit(void);
+void AltimeterStartTask(void);
+void AltimeterGetState(AltimeterStateT* state);
+
+#endif // !ALTIMETER_H
@@ -1,104 +1,216 @@
-/*
-	APRS Packet Encoder
-		-- Chris Seto, 2018
-
-	References:
-		* http://www.aprs.org/doc/APRS101.PDF
-
-	Example from tracksoar: "/000000h0000.00N/00000.00EO000/000/A=000000/11487/44.37/29.42"
-
-	/000000h0000.00N/00000.00EO000/000/A=000000/11487/44.37/29.42
-	/191920h3850.86N/09016.92W-Test123
-
-*/
-#include <stdio.h>
-#include <math.h>
-#include <string.h>
-#include <time.h>
-#include "Aprs.h"
-
-// APRS101, Page 34
-// 19 bytes
-static void AprsMakePositionCoordinates(uint8_t* buffer, const AprsPositionT* position)
-{
-	// Get elements of lat
-	float latAbs = fabs(position->Lat);
-	float latWhole = floorf(latAbs);
-	float latMinutes = (latAbs - latWhole) * 60.0;
-	float latSeconds = (latMinutes - floorf(latMinutes)) * 100.0;
-	uint8_t latChar = (position->Lat > 0) ? 'N' : 'S';
-
-	// Get elements of lon
-	float lonAbs = fabs(position->Lon);
-	float lonWhole = floorf(lonAbs);
-	float lonMinutes = (lonAbs - lonWhole) * 60.0;
-	float lonSeconds = (lonMinutes - floorf(lonMinutes)) * 100.0;
-	uint8_t lonChar = (position->Lon > 0) ? 'E' : 'W';
-
-	// Format the buffer
-	sprintf((char*)buffer, "%02lu%02lu.%02lu%c%c%03lu%02lu.%02lu%c%c", 
-		(uint32_t)latWhole,
-		(uint32_t)latMinutes,
-		(uint32_t)latSeconds,
-		latChar,
-		position->SymbolTable,
-		(uint32_t)lonWhole,
-		(uint32_t)lonMinutes,
-		(uint32_t)lonSeconds,
-		lonChar,
-		position->Symbol);
-}
-
-// APRS101, Page 32
-// 7 bytes
-static void AprsMakeTimeHms(uint8_t* buffer, const uint32_t timestamp)
-{
-	struct tm* timeStruct;
-
-	// Extract timestamp
-	timeStruct = gmtime((long*)&timestamp);
-
-	// Check if we got a valid time back
-	if (timeStruct == NULL)
-	{
-		sprintf((char*)buffer, "000000h");
-		return;
-	}
-
-	// Format buffer
-	sprintf((char*)buffer, "%02d%02d%02dh", timeStruct->tm_hour, timeStruct->tm_min, timeStruct->tm_sec);
-}
-
-// APRS101, Page 32
-const uint32_t AprsMakePosition(uint8_t* buffer, const AprsPositionReportT* report)
-{
-	uint32_t i;
-	uint32_t bufferPtr = 0;
-
-	// Position report, with timestamp, no messaging
-	buffer[bufferPtr++] = '/';
-
-	// Encode timestamp
-	if (!report->Timestamp)
-	{
-		sprintf((char*)buffer + bufferPtr, "000000h");
-	}
-	else
-	{
-		AprsMakeTimeHms(buffer + bufferPtr, report->Timestamp);
-	}
-	bufferPtr += 7;
-
-	// Encode position
-	// 19 Bytes
-	AprsMakePositionCoordinates(buffer + bufferPtr, &report->Position);
-	bufferPtr += 19;
-
-	return bufferPtr;
-}
-
-const uint32_t AprsMakeExtCourseSpeed(uint8_t* buffer, const uint8_t course, const uint16_t speed)
-{
-	sprintf((char*)buffer, "%03d/%03d/", course, speed);
-	return 8;
+/*
+	APRS Packet Encoder
+		-- Chris Seto, 2018
+
+	References:
+		* http://www.aprs.org/doc/APRS101.PDF
+
+	Example from tracksoar: "/000000h0000.00N/00000.00EO000/000/A=000000/11487/44.37/29.42"
+
+	/000000h0000.00N/00000.00EO000/000/A=000000/11487/44.37/29.42
+	/191920h3850.86N/09016.92W-Test123
+
+*/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include "Aprs.h"
+
+#define METERS_TO_FEET			3.28084f
+
+// 1e-7 degrees of latitude per metre
+#define DEGREES_PER_METER		89.8315f
+
+#define DEGREES_TO_RADIANS		1.745329e-9f
+
+// APRS101, Page 34
+// 19 bytes
+// Split 1e-7 degrees into whole degrees and hundredths of a minute, rounded
+static void AprsSplitCoordinate(const int32_t coordinate, uint32_t* degrees, uint32_t* hundredths)
+{
+	uint32_t magnitude = (coordinate < 0) ? -(uint32_t)coordinate : (uint32_t)coordinate;
+
+	*degrees = magnitude / 10000000;
+	*hundredths = ((magnitude % 10000000) * 6 + 5000) / 10000;
+
+	// Rounded up into the next degree
+	if (*hundredths == 6000)
+	{
+		*degrees += 1;
+		*hundredths = 0;
+	}
+}
+
+static void AprsMakePositionCoordinates(uint8_t* buffer, const AprsPositionT* position)
+{
+	uint32_t latDegrees;
+	uint32_t latHundredths;
+	uint32_t lonDegrees;
+	uint32_t lonHundredths;
+
+	AprsSplitCoordinate(position->Lat, &latDegrees, &latHundredths);
+	AprsSplitCoordinate(position->Lon, &lonDegrees, &lonHundredths);
+
+	// Format the buffer
+	sprintf((char*)buffer, "%02lu%02lu.%02lu%c%c%03lu%02lu.%02lu%c%c", 
+		latDegrees,
+		latHundredths / 100,
+		latHundredths % 100,
+		(position->Lat >= 0) ? 'N' : 'S',
+		position->SymbolTable,
+		lonDegrees,
+		lonHundredths / 100,
+		lonHundredths % 100,
+		(position->Lon >= 0) ? 'E' : 'W',
+		position->Symbol);
+}
+
+// APRS101, Page 32
+// 7 bytes
+static void AprsMakeTimeHms(uint8_t* buffer, const uint32_t timestamp)
+{
+	struct tm* timeStruct;
+
+	// Extract timestamp
+	timeStruct = gmtime((long*)&timestamp);
+
+	// Check if we got a valid time back
+	if (timeStruct == NULL)
+	{
+		sprintf((char*)buffer, "000000h");
+		return;
+	}
+
+	// Format buffer
+	sprintf((char*)buffer, "%02d%02d%02dh", timeStruct->tm_hour, timeStruct->tm_min, timeStruct->tm_sec);
+}
+
+// APRS101, Page 32
+const uint32_t AprsMakePosition(uint8_t* buffer, const AprsPositionReportT* report)
+{
+	uint32_t i;
+	uint32_t bufferPtr = 0;
+
+	// Position report, with timestamp, no messaging
+	buffer[bufferPtr++] = '/';
+
+	// Encode timestamp
+	if (!report->Timestamp)
+	{
+		sprintf((char*)buffer + bufferPtr, "000000h");
+	}
+	else
+	{
+		AprsMakeTimeHms(buffer + bufferPtr, report->Timestamp);
+	}
+	bufferPtr += 7;
+
+	// Encode position
+	// 19 Bytes
+	AprsMakePositionCoordinates(buffer + bufferPtr, &report->Position);
+	bufferPtr += 19;
+
+	return bufferPtr;
+}
+
+// APRS101, Page 58
+// 37 bytes, name is APRS_OBJECT_NAME_SIZE long and space padded
+const uint32_t AprsMakeObject(uint8_t* buffer, const uint8_t* name, const AprsPositionReportT* report)
+{
+	uint32_t bufferPtr = 0;
+
+	// Object, live
+	buffer[bufferPtr++] = ';';
+	memcpy(buffer + bufferPtr, name, APRS_OBJECT_NAME_SIZE);
+	bufferPtr += APRS_OBJECT_NAME_SIZE;
+	buffer[bufferPtr++] = '*';
+
+	// Encode timestamp
+	if (!report->Timestamp)
+	{
+		sprintf((char*)buffer + bufferPtr, "000000h");
+	}
+	else
+	{
+		AprsMakeTimeHms(buffer + bufferPtr, report->Timestamp);
+	}
+	bufferPtr += 7;
+
+	// Encode position
+	// 19 Bytes
+	AprsMakePositionCoordinates(buffer + bufferPtr, &report->Position);
+	bufferPtr += 19;
+
+	return bufferPtr;
+}
+
+const uint32_t AprsMakeExtCourseSpeed(uint8_t* buffer, const uint8_t course, const uint16_t speed)
+{
+	sprintf((char*)buffer, "%03d/%03d/", course, speed);
+	return 8;
+}
+
+// APRS101, Page 26
+// 8 bytes, altitude in metres
+const uint32_t AprsMakeAltitude(uint8_t* buffer, const float altitude)
+{
+	sprintf((char*)buffer, "A=%06i", (int)(altitude * METERS_TO_FEET));
+	return 8;
+}
+
+// Dead reckon a report dt ms forward and rewrite it in place
+// Only the fixed width fields are touched, everything after them stays where it is
+void AprsRefreshPosition(uint8_t* payload, const AprsLivePositionT* live, const int32_t dt)
+{
+	AprsPositionReportT report = live->Report;
+	uint8_t buffer[28];
+	float seconds = dt / 1000.0f;
+	float cosLat;
+	int32_t lat;
+	int32_t lon;
+
+	// Flat earth is plenty over a few seconds
+	cosLat = cosf(report.Position.Lat * DEGREES_TO_RADIANS);
+	lat = report.Position.Lat + (int32_t)(live->VelocityNorth * seconds * DEGREES_PER_METER);
+	lon = report.Position.Lon;
+
+	if (cosLat > 0.01f)
+	{
+		lon += (int32_t)(live->VelocityEast * seconds * DEGREES_PER_METER / cosLat);
+	}
+
+	if (lat > 900000000)
+	{
+		lat = 900000000;
+	}
+	else if (lat < -900000000)
+	{
+		lat = -900000000;
+	}
+
+	if (lon > 1800000000)
+	{
+		lon -= 3600000000LL;
+	}
+	else if (lon < -1800000000)
+	{
+		lon += 3600000000LL;
+	}
+
+	report.Position.Lat = lat;
+	report.Position.Lon = lon;
+
+	if (report.Timestamp != 0)
+	{
+		report.Timestamp += (dt + 500) / 1000;
+	}
+
+	// sprintf terminates, so build aside and copy without the NUL
+	memcpy(payload, buffer, AprsMakePosition(buffer, &report));
+
+	if (live->HaveAltitude)
+	{
+		memcpy(payload + live->AltitudeOffset, buffer, AprsMakeAltitude(buffer, live->Altitude + live->VelocityUp * seconds));
+	}
 }
\ No newline at end of file
@@ -1,22 +1,46 @@
-#ifndef APRS_H
-#define APRS_H
-#include <stdint.h>
-
-typedef struct
-{
-	float Lat;
-	float Lon;
-	uint8_t SymbolTable;
-	uint8_t Symbol;
-} AprsPositionT;
-
-typedef struct
-{
-	AprsPositionT Position;
-	uint32_t Timestamp;
-} AprsPositionReportT;
-
-const uint32_t AprsMakePosition(uint8_t* buffer, const AprsPositionReportT* report);
-const uint32_t AprsMakeExtCourseSpeed(uint8_t* buffer, const uint8_t course, const uint16_t speed);
-
-#endif // !APRS_H
+#ifndef APRS_H
+#define APRS_H
+#include <stdint.h>
+
+typedef struct
+{
+	int32_t Lat;
+	int32_t Lon;
+	uint8_t SymbolTable;
+	uint8_t Symbol;
+} AprsPositionT;
+
+typedef struct
+{
+	AprsPositionT Position;
+	uint32_t Timestamp;
+} AprsPositionReportT;
+
+#define APRS_OBJECT_NAME_SIZE	9
+
+// Where the coordinates sit in a position report
+#define APRS_COORDINATE_OFFSET	8
+
+// Furthest a position is carried forward in ms, an older one goes out as of its fix
+#define APRS_MAX_EXTRAPOLATION	5000
+
+// A report at the start of a payload, and what's needed to carry it forward in time
+// Velocities in m/s
+typedef struct
+{
+	AprsPositionReportT Report;
+	uint8_t HaveAltitude;
+	uint8_t AltitudeOffset;
+	float Altitude;
+	float VelocityNorth;
+	float VelocityEast;
+	float VelocityUp;
+} AprsLivePositionT;
+
+const uint32_t AprsMakePosition(uint8_t* buffer, const AprsPositionReportT* report);
+const uint32_t AprsMakeObject(uint8_t* buffer, const uint8_t* name, const AprsPositionReportT* report);
+const uint32_t AprsMakeExtCourseSpeed(uint8_t* buffer, const uint8_t course, const uint16_t speed);
+const uint32_t AprsMakeAltitude(uint8_t* buffer, const float altitude);
+void AprsRefreshPosition(uint8_t* payload, const AprsLivePositionT* live, const int32_t dt);
+
+#endif // !APRS_H
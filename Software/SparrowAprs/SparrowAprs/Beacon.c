@@ -1,180 +1,337 @@
-#include <stm32f4xx_hal.h>
-#include "FreeRTOS.h"
-#include "task.h"
-#include <math.h>
-#include <stdint.h>
-#include <string.h>
-#include "Ax25.h"
-#include "Aprs.h"
-#include "Beacon.h"
-#include "Led.h"
-#include "Rtc.h"
-#include "time.h"
-#include "Radio.h"
-#include "Config.h"
-#include "FlashConfig.h"
-#include "Bme280Shim.h"
-#include "Bsp.h"
-#include "GpsHub.h"
-
-// APRS packet buffer
-#define PACKET_BUFFER_SIZE		500
-static uint8_t aprsBuffer[PACKET_BUFFER_SIZE];
-
-void BeaconTask(void* pvParameters);
-static TaskHandle_t beaconTaskHandle = NULL;
-
-#define FIRST_BEACON_OFFSET		500
-
-#define PREFLAG_COUNT		10
-#define POSTFLAG_COUNT		25
-
-void BeaconInit(void)
-{
-}
-
-void BeaconStartTask(void)
-{
-	// Create task
-	xTaskCreate(BeaconTask,
-		"Beacon",
-		450,
-		NULL,
-		3,
-		&beaconTaskHandle);
-}
-
-#define METERS_TO_FEET	3.28084f
-static float Meters2Feet(const float m)
-{
-	return m * METERS_TO_FEET;
-}
-
-static uint32_t CalculateSmartBeacon(const uint32_t minTime,
-	const uint32_t maxTime,
-	const float speed,
-	const float dSpeed,
-	const float dHeading,
-	const float cS,
-	const float cDs,
-	const float cDh)
-{
-	uint32_t margin = maxTime - minTime;
-	uint32_t score = 0;
-	uint32_t weightSpeed;
-	uint32_t weightdSpeed;
-	uint32_t weightdHeading;
-
-	// Calculate weights
-	score += cDs * dSpeed;
-	score += cS * speed;
-	score += cDh * dHeading;
-
-	if (score < maxTime)
-	{
-		margin -= score;
-	}
-	else
-	{
-		margin = 0;
-	}
-
-	return minTime + margin;
-}
-
-void BeaconTask(void* pvParameters)
-{
-	QueueHandle_t* txQueue;
-	TickType_t lastTaskTime = 0;
-	uint32_t aprsLength;
-	AprsPositionReportT aprsReport;
-	RadioPacketT beaconPacket;
-	uint32_t beaconPeriod;
-	float temperature;
-	float pressure;
-	float humidity;
-	SituationInfoT situation;
-
-	// Get config
-	ConfigT* config = FlashConfigGetPtr();
-
-	// Get the queues
-	txQueue = RadioGetTxQueue();
-
-	// If we didn't get any queues, something is really wrong
-	if (txQueue == NULL)
-	{
-		return;
-	}
-
-	// Beacon quickly on the first start
-	beaconPeriod = FIRST_BEACON_OFFSET;
-
-	// Beacon loop
-	while (1)
-	{
-		// Block until it's time to start
-		vTaskDelayUntil(&lastTaskTime, beaconPeriod);
-
-		// Get the latest situation
-		GpsHubGetSituation(&situation);
-
-		// Get the current environmental data
-		Bme280ShimGetTph(&temperature, &pressure, &humidity);
-
-		// Compute smart beacon period
-		if (config->Aprs.UseSmartBeacon)
-		{
-			beaconPeriod = CalculateSmartBeacon(config->Aprs.BeaconPeriod,
-				config->Aprs.SmartBeaconMinimumBeaconPeriod,
-				situation.Speed, situation.dSpeed,
-				situation.dTrack,
-				config->Aprs.SmartBeaconWeightSpeed,
-				config->Aprs.SmartBeaconWeightdSpeed,
-				config->Aprs.SmartBeaconWeightdHeading
-			);
-		}
-		else
-		{
-			beaconPeriod = config->Aprs.BeaconPeriod;
-		}
-	
-		// Configure Ax25 frame
-		memcpy(beaconPacket.Frame.Source, config->Aprs.Callsign, 6);
-		beaconPacket.Frame.SourceSsid = config->Aprs.Ssid;
-		memcpy(beaconPacket.Frame.Destination, "APRS  ", 6);
-		beaconPacket.Frame.DestinationSsid = 0;
-		memcpy(beaconPacket.Path, config->Aprs.Path, 7);
-		beaconPacket.Frame.PathLen = 7;
-
-		beaconPacket.Frame.PreFlagCount = PREFLAG_COUNT;
-		beaconPacket.Frame.PostFlagCount = POSTFLAG_COUNT;
-
-		// Fill APRS report
-		aprsReport.Timestamp = RtcGet();
-		aprsReport.Position.Lat = situation.Lat;
-		aprsReport.Position.Lon = situation.Lon;
-		aprsReport.Position.Symbol = config->Aprs.Symbol;
-		aprsReport.Position.SymbolTable = config->Aprs.SymbolTable;
-
-		// Build APRS report
-		aprsLength = 0;
-		aprsLength += AprsMakePosition(aprsBuffer, &aprsReport);
-		aprsLength += AprsMakeExtCourseSpeed(aprsBuffer + aprsLength, (uint8_t)situation.Track, (uint16_t)situation.Speed);
-
-		// Append comment for GPS altitude
-		sprintf((char*)aprsBuffer + aprsLength, "A=%06i", (int)Meters2Feet(situation.Altitude));
-		aprsLength += 8;
-
-		// Add telemetry comment
-		sprintf((char*)aprsBuffer + aprsLength, "/Pa=%06i/Rh=%02.02f/Ti=%02.02f/V=%02.02f", (int)pressure, humidity, temperature, BspGetVSense());
-		aprsLength += 35;
-
-		// Add the APRS report to the packet
-		memcpy(beaconPacket.Payload, aprsBuffer, aprsLength);
-		beaconPacket.Frame.PayloadLength = aprsLength;
-
-		// Enqueue the packet in the transmit buffer
-		xQueueSendToBack(txQueue, &beaconPacket, 0);
-	}
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "Ax25.h"
+#include "Aprs.h"
+#include "Beacon.h"
+#include "Led.h"
+#include "Rtc.h"
+#include "time.h"
+#include "Radio.h"
+#include "PacketPool.h"
+#include "Config.h"
+#include "FlashConfig.h"
+#include "Altimeter.h"
+#include "Bsp.h"
+#include "GpsHub.h"
+#include "GpsDuty.h"
+#include "Landing.h"
+
+// APRS packet buffer
+#define PACKET_BUFFER_SIZE		500
+static uint8_t aprsBuffer[PACKET_BUFFER_SIZE];
+
+void BeaconTask(void* pvParameters);
+static TaskHandle_t beaconTaskHandle = NULL;
+
+#define FIRST_BEACON_OFFSET		500
+
+#define PREFLAG_COUNT		10
+#define POSTFLAG_COUNT		25
+
+// A fix older than this at beacon time is worth waiting a little for a fresh one
+#define FIX_FRESH_AGE		2000
+#define FIX_WAIT			5000
+
+// Altitude loss between beacons, in meters, before we consider ourselves descending
+#define DESCENT_THRESHOLD	50.0f
+
+// Or, with the altimeter running, sinking faster than this in m/s
+#define DESCENT_SPEED		-2.0f
+
+// The hub timestamps an epoch when its first sentence is parsed, the fix itself is from about this much earlier
+#define GPS_OUTPUT_LATENCY	100
+
+// Predicted landing goes out with every this many beacons once there is one
+#define LANDING_EVERY		2
+
+// A prediction older than this many beacon periods has stopped being updated, we've landed or lost GPS
+#define LANDING_MAX_AGE		3
+
+#define KNOTS_TO_MPS		0.514444f
+#define DEGREES_TO_RADIANS	0.0174533f
+
+void BeaconInit(void)
+{
+}
+
+void BeaconStartTask(void)
+{
+	// Create task
+	xTaskCreate(BeaconTask,
+		"Beacon",
+		450,
+		NULL,
+		3,
+		&beaconTaskHandle);
+
+	// Woken by the hub on new fixes
+	GpsHubSubscribe(beaconTaskHandle);
+}
+
+static uint32_t CalculateSmartBeacon(const uint32_t minTime,
+	const uint32_t maxTime,
+	const float speed,
+	const float dSpeed,
+	const float dHeading,
+	const float cS,
+	const float cDs,
+	const float cDh)
+{
+	uint32_t margin = maxTime - minTime;
+	uint32_t score = 0;
+	uint32_t weightSpeed;
+	uint32_t weightdSpeed;
+	uint32_t weightdHeading;
+
+	// Calculate weights
+	score += cDs * dSpeed;
+	score += cS * speed;
+	score += cDh * dHeading;
+
+	if (score < maxTime)
+	{
+		margin -= score;
+	}
+	else
+	{
+		margin = 0;
+	}
+
+	return minTime + margin;
+}
+
+// Addressing common to everything we send
+static void FillFrame(RadioPacketT* packet, const ConfigT* config)
+{
+	memcpy(packet->Frame.Source, config->Aprs.Callsign, 6);
+	packet->Frame.SourceSsid = config->Aprs.Ssid;
+	memcpy(packet->Frame.Destination, "APRS  ", 6);
+	packet->Frame.DestinationSsid = 0;
+	memcpy(packet->Path, config->Aprs.Path, 7);
+	packet->Frame.PathLen = 7;
+
+	packet->Frame.PreFlagCount = PREFLAG_COUNT;
+	packet->Frame.PostFlagCount = POSTFLAG_COUNT;
+}
+
+// Send the predicted landing point as an object named after us, CALL-LP
+static void SendLanding(const LandingPredictionT* prediction, const ConfigT* config, const TickType_t lifetime)
+{
+	RadioPacketT* packet;
+	AprsPositionReportT report;
+	uint8_t name[APRS_OBJECT_NAME_SIZE];
+	uint32_t nameLength = 0;
+	uint32_t length;
+	TickType_t ticks = xTaskGetTickCount() - prediction->Timestamp;
+	uint32_t age = ticks * portTICK_PERIOD_MS / 1000;
+
+	// Don't keep pointing the recovery crew at a prediction nobody is making any more
+	// The lifetime is one beacon period
+	if (ticks > LANDING_MAX_AGE * lifetime || age >= prediction->TimeToLanding)
+	{
+		return;
+	}
+
+	packet = PacketPoolAlloc();
+
+	if (packet == NULL)
+	{
+		return;
+	}
+
+	FillFrame(packet, config);
+
+	memset(name, ' ', sizeof(name));
+
+	while (nameLength < 6 && config->Aprs.Callsign[nameLength] != ' ')
+	{
+		name[nameLength] = config->Aprs.Callsign[nameLength];
+		nameLength++;
+	}
+
+	memcpy(name + nameLength, "-LP", 3);
+
+	report.Timestamp = RtcGet();
+	report.Position.Lat = prediction->Lat;
+	report.Position.Lon = prediction->Lon;
+	report.Position.SymbolTable = config->Aprs.SymbolTable;
+	report.Position.Symbol = config->Aprs.Symbol;
+
+	length = AprsMakeObject(aprsBuffer, name, &report);
+	// Counted down from when the prediction was made
+	length += sprintf((char*)aprsBuffer + length, "Landing in %lus", prediction->TimeToLanding - age);
+
+	memcpy(packet->Payload, aprsBuffer, length);
+	packet->Frame.PayloadLength = length;
+
+	// Just behind our own position
+	RadioEnqueue(packet, RADIO_PRIORITY_POSITION, lifetime);
+}
+
+void BeaconTask(void* pvParameters)
+{
+	TickType_t lastTaskTime = 0;
+	uint32_t aprsLength;
+	AprsLivePositionT* live;
+	RadioPacketT* beaconPacket;
+	uint32_t beaconPeriod;
+	AltimeterStateT altimeter;
+	SituationInfoT situation;
+	float lastAltitude = 0;
+	uint8_t descending = 0;
+	uint32_t beaconCount = 0;
+	LandingPredictionT landing;
+	uint8_t fresh;
+
+	// Get config
+	ConfigT* config = FlashConfigGetPtr();
+
+	// Beacon quickly on the first start
+	beaconPeriod = FIRST_BEACON_OFFSET;
+
+	// Beacon loop
+	while (1)
+	{
+		// Block until it's time to start
+		vTaskDelayUntil(&lastTaskTime, beaconPeriod);
+
+		// Get the latest situation
+		// If it's stale the receiver may just be back from sleep, give it a moment to produce a fresh one
+		fresh = 1;
+
+		if (!GpsHubGetSituation(&situation) || xTaskGetTickCount() - situation.Timestamp > FIX_FRESH_AGE)
+		{
+			fresh = GpsHubWaitSituation(&situation, situation.Sequence, FIX_WAIT);
+		}
+
+		// Until the receiver has a fix all we'd be reporting is 0,0
+		if (situation.Sequence == 0 || !situation.FixValid)
+		{
+			beaconPeriod = FIRST_BEACON_OFFSET;
+			continue;
+		}
+
+		// Get the current environmental data and vertical state
+		AltimeterGetState(&altimeter);
+
+		// Compute smart beacon period
+		if (config->Aprs.UseSmartBeacon)
+		{
+			beaconPeriod = CalculateSmartBeacon(config->Aprs.BeaconPeriod,
+				config->Aprs.SmartBeaconMinimumBeaconPeriod,
+				situation.Speed, situation.dSpeed,
+				situation.dTrack,
+				config->Aprs.SmartBeaconWeightSpeed,
+				config->Aprs.SmartBeaconWeightdSpeed,
+				config->Aprs.SmartBeaconWeightdHeading
+			);
+		}
+		else
+		{
+			beaconPeriod = config->Aprs.BeaconPeriod;
+		}
+
+		// Position reports on the way down are what recovery depends on
+		// The altimeter sees it first, otherwise a fix without altitude leaves the last verdict standing
+		if (altimeter.Valid)
+		{
+			descending = altimeter.Burst || altimeter.VerticalSpeed < DESCENT_SPEED;
+		}
+		else if (situation.AltitudeValid)
+		{
+			descending = (lastAltitude - situation.Altitude > DESCENT_THRESHOLD);
+			lastAltitude = situation.Altitude;
+		}
+
+		// Let the GPS sleep until just before the next beacon, unless we're coming down and need every fix
+		GpsDutySchedule(lastTaskTime + beaconPeriod, descending);
+	
+		// Get a packet to build into. If the pool is dry, the radio is backed up and this beacon can be skipped
+		beaconPacket = PacketPoolAlloc();
+
+		if (beaconPacket == NULL)
+		{
+			continue;
+		}
+
+		// Configure Ax25 frame
+		FillFrame(beaconPacket, config);
+
+		// Fill APRS report, as of the fix
+		// The radio carries it forward to the moment it goes on air
+		live = &beaconPacket->Live;
+		beaconPacket->LiveFixTime = situation.Timestamp - GPS_OUTPUT_LATENCY / portTICK_PERIOD_MS;
+		live->Report.Timestamp = RtcGet();
+
+		if (live->Report.Timestamp != 0)
+		{
+			live->Report.Timestamp -= (xTaskGetTickCount() - beaconPacket->LiveFixTime) * portTICK_PERIOD_MS / 1000;
+		}
+
+		live->Report.Position.Lat = situation.Lat;
+		live->Report.Position.Lon = situation.Lon;
+		live->Report.Position.Symbol = config->Aprs.Symbol;
+		live->Report.Position.SymbolTable = config->Aprs.SymbolTable;
+		live->VelocityNorth = situation.VelocityValid ? situation.Speed * KNOTS_TO_MPS * cosf(situation.Track * DEGREES_TO_RADIANS) : 0;
+		live->VelocityEast = situation.VelocityValid ? situation.Speed * KNOTS_TO_MPS * sinf(situation.Track * DEGREES_TO_RADIANS) : 0;
+		live->VelocityUp = altimeter.Valid ? altimeter.VerticalSpeed : situation.dAltitude;
+
+		// Build APRS report
+		aprsLength = 0;
+		aprsLength += AprsMakePosition(aprsBuffer, &live->Report);
+
+		// Course and speed, if this fix had them
+		if (situation.VelocityValid)
+		{
+			aprsLength += AprsMakeExtCourseSpeed(aprsBuffer + aprsLength, (uint8_t)situation.Track, (uint16_t)situation.Speed);
+		}
+
+		// Append comment for altitude, GPS if this fix had it, the altimeter's through a dropout
+		// The altimeter's is taken back to the time of the fix so both extrapolate the same way
+		live->HaveAltitude = situation.AltitudeValid || altimeter.Valid;
+
+		if (live->HaveAltitude)
+		{
+			live->Altitude = situation.AltitudeValid ? situation.Altitude
+				: altimeter.Altitude - altimeter.VerticalSpeed * (int32_t)(altimeter.Timestamp - beaconPacket->LiveFixTime) * portTICK_PERIOD_MS / 1000.0f;
+			live->AltitudeOffset = aprsLength;
+			aprsLength += AprsMakeAltitude(aprsBuffer + aprsLength, live->Altitude);
+		}
+
+		// Add telemetry comment
+		sprintf((char*)aprsBuffer + aprsLength, "/Pa=%06i/Rh=%02.02f/Ti=%02.02f/V=%02.02f", (int)altimeter.Pressure, altimeter.Humidity, altimeter.Temperature, BspGetVSense());
+		aprsLength += 35;
+
+		// Add the APRS report to the packet
+		memcpy(beaconPacket->Payload, aprsBuffer, aprsLength);
+		beaconPacket->Frame.PayloadLength = aprsLength;
+
+		// Carried forward to its time on air, unless the receiver had nothing new or the fix is too old to trust
+		// Otherwise it goes out where and when the fix was
+		beaconPacket->LivePosition = fresh
+			&& (xTaskGetTickCount() - beaconPacket->LiveFixTime) * portTICK_PERIOD_MS <= APRS_MAX_EXTRAPOLATION;
+
+		if (!beaconPacket->LivePosition)
+		{
+			live->VelocityNorth = 0;
+			live->VelocityEast = 0;
+			live->VelocityUp = 0;
+		}
+
+		// Enqueue the packet in the transmit buffer
+		// It is stale once the next beacon has been generated
+		RadioEnqueue(beaconPacket, descending ? RADIO_PRIORITY_DESCENT_POSITION : RADIO_PRIORITY_POSITION, beaconPeriod);
+
+		// Where we're going to come down, for the recovery crew
+		beaconCount++;
+
+		if (beaconCount % LANDING_EVERY == 0 && LandingGetPrediction(&landing))
+		{
+			SendLanding(&landing, config, beaconPeriod);
+		}
+	}
 }
\ No newline at end of file
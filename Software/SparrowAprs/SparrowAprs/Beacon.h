@@ -1,7 +1,7 @@
-#ifndef BEACON_H
-
-void BeaconInit(void);
-void BeaconStartTask(void);
-
-
-#endif // !BEACON_H
+#ifndef BEACON_H
+
+void BeaconInit(void);
+void BeaconStartTask(void);
+
+
+#endif // !BEACON_H
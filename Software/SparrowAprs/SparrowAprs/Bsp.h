@@ -1,9 +1,9 @@
-#ifndef BSP_H
-#define BSP_H
-
-void BspInit(void);
-float BspGetVSense(void);
-float BspGetuCTemperature(void);
-
-
-#endif // !BSP_H
+#ifndef BSP_H
+#define BSP_H
+
+void BspInit(void);
+float BspGetVSense(void);
+float BspGetuCTemperature(void);
+
+
+#endif // !BSP_H
@@ -0,0 +1,266 @@
+/*
+	Clock profiles
+
+	We only need the full 168Mhz while the modem is working (encoding,
+	decoding or streaming audio). The rest of the time the system runs
+	straight from the 25Mhz HSE with both APB buses undivided.
+
+	The PLL is left running in both profiles so USB always has its 48Mhz
+	and switching is just a SYSCLK mux change. SysTick is reprogrammed by
+	the HAL on every switch, everything else that derives a rate from a bus
+	clock (UART baud, audio sample timer, I2C) registers a callback here.
+
+	A bus transaction can't survive its clock changing under it, so anyone
+	in the middle of one holds the profile lock and switches wait for them.
+*/
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "Crash.h"
+#include "Clock.h"
+
+static void ClockConfigPll(void);
+static void ClockApplyProfile(const uint8_t full);
+static void ClockFailed(const uint16_t step);
+
+#define CLOCK_CALLBACK_COUNT	6
+static void(*callbacks[CLOCK_CALLBACK_COUNT])(void);
+static uint32_t callbackCount = 0;
+
+// Register polls for when there's no tick to time out with, tens of ms on HSI
+// HSE is given up to 100ms by the HAL, it's normally up in a couple
+#define POLL_LIMIT				200000
+
+// Users currently holding full speed
+static uint32_t fullUsers = CLOCK_USER_BOOT;
+static uint8_t isFull = 0;
+
+// Held across anything a profile switch would break
+static SemaphoreHandle_t profileMutex;
+
+// Configure clock system
+void ClockInit(void)
+{
+	RCC_OscInitTypeDef RCC_OscInitStruct;
+	RCC_PeriphCLKInitTypeDef PeriphClkInitStruct;
+
+	profileMutex = xSemaphoreCreateMutex();
+
+	// Enable clocks
+	__HAL_RCC_PWR_CLK_ENABLE();
+  
+	/* The voltage scaling allows optimizing the power consumption when the device is 
+	   clocked below the maximum system frequency, to update the voltage scaling value 
+	   regarding system frequency refer to product datasheet.  */
+	__HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+
+	// Bring up HSE and the PLL, start at full speed until boot is done
+	ClockConfigPll();
+	ClockApplyProfile(1);
+
+	// Enable LSI for watchdog and RTC
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSI | RCC_OSCILLATORTYPE_LSE;
+	RCC_OscInitStruct.PLL.PLLState   = RCC_PLL_NONE;
+	RCC_OscInitStruct.LSEState       = RCC_LSE_OFF;
+	RCC_OscInitStruct.LSIState       = RCC_LSI_ON;
+
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	{
+		ClockFailed(3);
+	}
+
+	// Connect LSI to RTC
+	// HSE is stopped in STOP mode, so it can't be used to wake us up
+	PeriphClkInitStruct.PeriphClockSelection = RCC_PERIPHCLK_RTC;
+	PeriphClkInitStruct.RTCClockSelection = RCC_RTCCLKSOURCE_LSI;
+	HAL_RCCEx_PeriphCLKConfig(&PeriphClkInitStruct);
+
+	// STM32F405x/407x/415x/417x Revision Z devices: prefetch is supported
+	if (HAL_GetREVID() == 0x1001)
+	{
+		// Enable flash prefetch
+		__HAL_FLASH_PREFETCH_BUFFER_ENABLE();
+	}
+}
+
+// Returns 0 if the bits never came up
+static uint8_t WaitBits(volatile uint32_t* reg, const uint32_t mask, const uint32_t value)
+{
+	uint32_t i;
+
+	for (i = 0; i < POLL_LIMIT; i++)
+	{
+		if ((*reg & mask) == value)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+// There's no running without HSE, the boot gets another go at starting it
+// Steps 0-2 are waking from STOP, 3 is LSI, 4 the PLL, 5 and 6 switching to full and low speed
+static void ClockFailed(const uint16_t step)
+{
+	CrashTrace(CRASH_TRACE_CLOCK_FAIL, step);
+	NVIC_SystemReset();
+}
+
+// STOP mode leaves us running from HSI with HSE and the PLL off
+// The PLL settings, bus dividers and flash latency all survive, only the sources need starting again
+// Runs with the tick stopped and interrupts masked, so no HAL calls that time out against the tick
+void ClockRestoreAfterStop(void)
+{
+	RCC->CR |= RCC_CR_HSEON;
+
+	if (!WaitBits(&RCC->CR, RCC_CR_HSERDY, RCC_CR_HSERDY))
+	{
+		ClockFailed(0);
+	}
+
+	RCC->CR |= RCC_CR_PLLON;
+
+	if (!WaitBits(&RCC->CR, RCC_CR_PLLRDY, RCC_CR_PLLRDY))
+	{
+		ClockFailed(1);
+	}
+
+	// Same source and so the same rates as before, nobody's dividers need fixing
+	RCC->CFGR = (RCC->CFGR & ~RCC_CFGR_SW) | (isFull ? RCC_CFGR_SW_PLL : RCC_CFGR_SW_HSE);
+
+	if (!WaitBits(&RCC->CFGR, RCC_CFGR_SWS, isFull ? RCC_CFGR_SWS_PLL : RCC_CFGR_SWS_HSE))
+	{
+		ClockFailed(2);
+	}
+}
+
+// Register a function to be called after every profile switch
+// Callbacks run with the scheduler suspended, so they must not block
+uint8_t ClockRegisterCallback(void(*callback)(void))
+{
+	if (callbackCount >= CLOCK_CALLBACK_COUNT)
+	{
+		return 0;
+	}
+
+	callbacks[callbackCount++] = callback;
+
+	return 1;
+}
+
+// Keep the profile from switching, for the length of a bus transaction
+void ClockLockProfile(void)
+{
+	xSemaphoreTake(profileMutex, portMAX_DELAY);
+}
+
+void ClockUnlockProfile(void)
+{
+	xSemaphoreGive(profileMutex);
+}
+
+void ClockRequestFull(const uint32_t user)
+{
+	ClockLockProfile();
+	vTaskSuspendAll();
+
+	fullUsers |= user;
+
+	if (!isFull)
+	{
+		ClockApplyProfile(1);
+	}
+
+	xTaskResumeAll();
+	ClockUnlockProfile();
+}
+
+void ClockReleaseFull(const uint32_t user)
+{
+	ClockLockProfile();
+	vTaskSuspendAll();
+
+	fullUsers &= ~user;
+
+	if (isFull && !fullUsers)
+	{
+		ClockApplyProfile(0);
+	}
+
+	xTaskResumeAll();
+	ClockUnlockProfile();
+}
+
+// Timers on APB1 run at twice PCLK1 unless the bus is undivided
+uint32_t ClockGetApb1TimerFreq(void)
+{
+	if ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_CFGR_PPRE1_DIV1)
+	{
+		return HAL_RCC_GetPCLK1Freq();
+	}
+
+	return HAL_RCC_GetPCLK1Freq() * 2;
+}
+
+static void ClockConfigPll(void)
+{
+	RCC_OscInitTypeDef RCC_OscInitStruct;
+
+	// HSE feeds PLL
+	RCC_OscInitStruct.OscillatorType		= RCC_OSCILLATORTYPE_HSE;
+	RCC_OscInitStruct.HSEState				= RCC_HSE_ON;
+	RCC_OscInitStruct.PLL.PLLState			= RCC_PLL_ON;
+	RCC_OscInitStruct.PLL.PLLSource			= RCC_PLLSOURCE_HSE;
+	RCC_OscInitStruct.PLL.PLLM				= 25;
+	RCC_OscInitStruct.PLL.PLLN				= 336;
+	RCC_OscInitStruct.PLL.PLLP				= RCC_PLLP_DIV2;
+	RCC_OscInitStruct.PLL.PLLQ				= 7;
+	
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+	{
+		ClockFailed(4);
+	}
+}
+
+static void ClockApplyProfile(const uint8_t full)
+{
+	RCC_ClkInitTypeDef RCC_ClkInitStruct;
+	uint32_t flashLatency;
+	uint32_t i;
+
+	RCC_ClkInitStruct.ClockType				= (RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2);
+	RCC_ClkInitStruct.AHBCLKDivider			= RCC_SYSCLK_DIV1;
+
+	if (full)
+	{
+		// 168Mhz from the PLL, 42Mhz APB1, 84Mhz APB2
+		RCC_ClkInitStruct.SYSCLKSource		= RCC_SYSCLKSOURCE_PLLCLK;
+		RCC_ClkInitStruct.APB1CLKDivider	= RCC_HCLK_DIV4;  
+		RCC_ClkInitStruct.APB2CLKDivider	= RCC_HCLK_DIV2;
+		flashLatency = FLASH_LATENCY_5;
+	}
+	else
+	{
+		// 25Mhz straight from HSE everywhere
+		RCC_ClkInitStruct.SYSCLKSource		= RCC_SYSCLKSOURCE_HSE;
+		RCC_ClkInitStruct.APB1CLKDivider	= RCC_HCLK_DIV1;  
+		RCC_ClkInitStruct.APB2CLKDivider	= RCC_HCLK_DIV1;
+		flashLatency = FLASH_LATENCY_0;
+	}
+
+	// This also reprograms SysTick for the new HCLK
+	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, flashLatency) != HAL_OK)
+	{
+		ClockFailed(full ? 5 : 6);
+	}
+
+	isFull = full;
+
+	// Let everyone fix up their dividers
+	for (i = 0; i < callbackCount; i++)
+	{
+		callbacks[i]();
+	}
+}
\ No newline at end of file
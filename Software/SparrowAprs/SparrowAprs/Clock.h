@@ -0,0 +1,19 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+// Anything that needs the full 168Mhz holds one of these
+#define CLOCK_USER_BOOT		(1 << 0)
+#define CLOCK_USER_MODEM	(1 << 1)
+
+void ClockInit(void);
+void ClockRestoreAfterStop(void);
+void ClockRequestFull(const uint32_t user);
+void ClockReleaseFull(const uint32_t user);
+void ClockLockProfile(void);
+void ClockUnlockProfile(void);
+uint8_t ClockRegisterCallback(void(*callback)(void));
+uint32_t ClockGetApb1TimerFreq(void);
+
+#endif // !CLOCK_H
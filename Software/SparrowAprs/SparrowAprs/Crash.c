@@ -0,0 +1,414 @@
+/*
+	Crash black box
+
+	A crash in flight resets us and whatever caused it is gone. This keeps
+	enough of it to find out afterwards, in the last 1KB of backup SRAM which
+	holds its contents through the reset:
+
+		CrashRecordT		written when something goes wrong
+		CrashTraceRingT		last few things that happened, written as they happen
+
+	The trace ring is written live, so it also covers the resets we never get
+	a look at, brownouts and watchdog bites. The boot entry in it carries the
+	reset cause. When we crash, the ring is copied into the record with the
+	registers, the task that was running, the top of its stack and the stack
+	high water mark of every task.
+
+	Captured on a HardFault, a stack overflow, a failed assert, and when the
+	watchdog hasn't been fed for long enough that it's about to bite. All but
+	the last reset straight away, the watchdog gets that one.
+
+	The record stays until it's cleared over USB, further crashes just count.
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+#include "Rtc.h"
+#include "CrcCcitt.h"
+#include "Usb.h"
+#include "Crash.h"
+
+// The top 1KB of backup SRAM, GpsAiding has the rest
+#define CRASH_BASE				(BKPSRAM_BASE + 3072)
+#define CRASH_SIZE				1024
+
+#define RECORD_MAGIC			0xC2A5B0C5
+#define RING_MAGIC				0x7A4CE000
+
+#define TRACE_COUNT				24
+#define STACK_WORDS				80
+#define TASK_COUNT				16
+#define TASK_NAME_SIZE			8
+#define FILE_NAME_SIZE			16
+
+typedef struct
+{
+	uint32_t Tick;
+	uint16_t Event;
+	uint16_t Argument;
+} CrashTraceT;
+
+typedef struct
+{
+	char Name[TASK_NAME_SIZE];
+	uint32_t HighWater;
+} CrashTaskT;
+
+// Fits in what's left after the trace ring, checked below
+typedef struct
+{
+	uint32_t Magic;
+	uint16_t Length;
+	uint16_t Crc;
+	uint32_t Cause;
+	uint32_t Count;
+	uint32_t Time;
+	uint32_t Tick;
+
+	// Exception frame, R0-R3, R12, LR, PC, xPSR
+	uint32_t Frame[8];
+	uint32_t Sp;
+	uint32_t ExcReturn;
+	uint32_t Cfsr;
+	uint32_t Hfsr;
+	uint32_t Mmfar;
+	uint32_t Bfar;
+
+	uint32_t Line;
+	char File[FILE_NAME_SIZE];
+	char Task[configMAX_TASK_NAME_LEN];
+
+	CrashTraceT Trace[TRACE_COUNT];
+	CrashTaskT Tasks[TASK_COUNT];
+	uint32_t Stack[STACK_WORDS];
+} CrashRecordT;
+
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t Head;
+	CrashTraceT Events[TRACE_COUNT];
+} CrashTraceRingT;
+
+// Growing a name, the trace or the stack copy must not push the record into the live ring
+_Static_assert(sizeof(CrashRecordT) + sizeof(CrashTraceRingT) <= CRASH_SIZE, "Crash record and trace ring overlap");
+
+#define crashRecord				((CrashRecordT*)CRASH_BASE)
+#define traceRing				((CrashTraceRingT*)(CRASH_BASE + CRASH_SIZE - sizeof(CrashTraceRingT)))
+
+// Report frames, '$' 'C' length record crc
+#define REPORT_HEADER			'$'
+#define REPORT_IDENT			'C'
+
+// Main SRAM, the only place a stack can be
+#define RAM_START				0x20000000
+#define RAM_END					0x20020000
+
+// Every task there is, from the create hook
+// uxTaskGetSystemState() takes critical sections, which we can't have in a fault handler
+static TaskHandle_t tasks[TASK_COUNT];
+static uint32_t taskCount = 0;
+
+static volatile uint8_t captured = 0;
+static volatile uint8_t reportRequested = 0;
+static volatile uint8_t clearRequested = 0;
+
+static uint16_t RecordCrc(void)
+{
+	return CrcCcitt((const uint8_t*)&crashRecord->Cause, sizeof(CrashRecordT) - 8);
+}
+
+static uint8_t RecordIsValid(void)
+{
+	return crashRecord->Magic == RECORD_MAGIC
+		&& crashRecord->Length == sizeof(CrashRecordT)
+		&& crashRecord->Crc == RecordCrc();
+}
+
+void CrashInit(void)
+{
+	uint32_t resetFlags = RCC->CSR >> 24;
+
+	// Same setup as the aiding store, whichever gets here first
+	__HAL_RCC_BKPSRAM_CLK_ENABLE();
+	HAL_PWR_EnableBkUpAccess();
+	HAL_PWREx_EnableBkUpReg();
+
+	__HAL_RCC_CLEAR_RESET_FLAGS();
+
+	// Cold power up, nothing in here is ours
+	if (traceRing->Magic != RING_MAGIC)
+	{
+		memset(traceRing, 0, sizeof(CrashTraceRingT));
+		traceRing->Magic = RING_MAGIC;
+	}
+
+	if (!RecordIsValid())
+	{
+		crashRecord->Magic = 0;
+	}
+	else
+	{
+		printf("Crash record: cause %lu, count %lu, pc %08lx, task %.*s\r\n",
+			crashRecord->Cause,
+			crashRecord->Count,
+			crashRecord->Frame[6],
+			configMAX_TASK_NAME_LEN,
+			crashRecord->Task);
+	}
+
+	CrashTrace(CRASH_TRACE_BOOT, resetFlags);
+}
+
+// traceTASK_CREATE, called by the kernel for every new task
+void CrashTaskCreated(void* task)
+{
+	if (taskCount < TASK_COUNT)
+	{
+		tasks[taskCount++] = task;
+	}
+}
+
+// Tasks, fault handlers, and interrupts allowed to call the kernel
+void CrashTrace(const uint16_t event, const uint16_t argument)
+{
+	uint32_t index = __atomic_fetch_add(&traceRing->Head, 1, __ATOMIC_RELAXED) % TRACE_COUNT;
+
+	traceRing->Events[index].Tick = xTaskGetTickCountFromISR();
+	traceRing->Events[index].Event = event;
+	traceRing->Events[index].Argument = argument;
+}
+
+// Seal the record, everything up to here survives if the next step faults
+static void Commit(void)
+{
+	crashRecord->Length = sizeof(CrashRecordT);
+	crashRecord->Crc = RecordCrc();
+	crashRecord->Magic = RECORD_MAGIC;
+}
+
+static void CopyString(char* destination, const char* source, const uint32_t size)
+{
+	uint32_t i;
+
+	for (i = 0; i < size; i++)
+	{
+		destination[i] = source != NULL ? source[i] : 0;
+
+		if (destination[i] == 0)
+		{
+			break;
+		}
+	}
+
+	for (; i < size; i++)
+	{
+		destination[i] = 0;
+	}
+}
+
+// Oldest first
+static void CopyTrace(void)
+{
+	uint32_t head = traceRing->Head;
+	uint32_t i;
+
+	for (i = 0; i < TRACE_COUNT; i++)
+	{
+		crashRecord->Trace[i] = traceRing->Events[(head + i) % TRACE_COUNT];
+	}
+}
+
+// As much of the stack above sp as is actually RAM
+static void CopyStack(const uint32_t sp)
+{
+	const uint32_t* stack = (const uint32_t*)sp;
+	uint32_t i;
+
+	for (i = 0; i < STACK_WORDS; i++)
+	{
+		crashRecord->Stack[i] = (sp >= RAM_START && sp + (i + 1) * 4 <= RAM_END) ? stack[i] : 0;
+	}
+}
+
+// Reads every task's TCB and stack, which may be what broke, so it goes last
+static void CopyTasks(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < taskCount; i++)
+	{
+		CopyString(crashRecord->Tasks[i].Name, pcTaskGetTaskName(tasks[i]), TASK_NAME_SIZE);
+		crashRecord->Tasks[i].HighWater = uxTaskGetStackHighWaterMark(tasks[i]);
+	}
+}
+
+static void Capture(const uint32_t cause, const uint32_t* frame, const uint32_t sp, const uint32_t excReturn, const char* task)
+{
+	uint32_t count = RecordIsValid() ? crashRecord->Count + 1 : 1;
+
+	// Faulting while capturing, what we have is all we'll get
+	if (captured)
+	{
+		return;
+	}
+
+	captured = 1;
+	crashRecord->Magic = 0;
+
+	crashRecord->Cause = cause;
+	crashRecord->Count = count;
+	crashRecord->Time = RtcGet();
+	crashRecord->Tick = xTaskGetTickCountFromISR();
+	crashRecord->Sp = sp;
+	crashRecord->ExcReturn = excReturn;
+	crashRecord->Cfsr = SCB->CFSR;
+	crashRecord->Hfsr = SCB->HFSR;
+	crashRecord->Mmfar = SCB->MMFAR;
+	crashRecord->Bfar = SCB->BFAR;
+	crashRecord->Line = 0;
+	memset(crashRecord->File, 0, sizeof(crashRecord->File));
+
+	if (frame != NULL && (uint32_t)frame >= RAM_START && (uint32_t)frame + sizeof(crashRecord->Frame) <= RAM_END)
+	{
+		memcpy(crashRecord->Frame, frame, sizeof(crashRecord->Frame));
+	}
+	else
+	{
+		memset(crashRecord->Frame, 0, sizeof(crashRecord->Frame));
+	}
+
+	if (task == NULL && xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+	{
+		task = pcTaskGetTaskName(NULL);
+	}
+
+	CopyString(crashRecord->Task, task, sizeof(crashRecord->Task));
+	CopyTrace();
+	CopyStack(sp);
+	memset(crashRecord->Tasks, 0, sizeof(crashRecord->Tasks));
+	Commit();
+
+	CopyTasks();
+	Commit();
+}
+
+// Called from HardFault_Handler with the stack the fault was taken on
+__attribute__((used)) void CrashFromFault(uint32_t* frame, const uint32_t excReturn)
+{
+	__disable_irq();
+
+	Capture(CRASH_CAUSE_HARDFAULT, frame, (uint32_t)frame, excReturn, NULL);
+
+	NVIC_SystemReset();
+}
+
+// Everything escalates to HardFault, the fault status registers say what it was
+// Work out which stack the exception frame went on and hand it over
+__attribute__((naked)) void HardFault_Handler(void)
+{
+	__asm volatile(
+		"tst lr, #4\n"
+		"ite eq\n"
+		"mrseq r0, msp\n"
+		"mrsne r0, psp\n"
+		"mov r1, lr\n"
+		"b CrashFromFault\n");
+}
+
+// The kernel caught a task running off the end of its stack at a context switch
+// The task's registers are on the stack it overflowed, so the frame is what was there
+void CrashStackOverflow(const char* task)
+{
+	__disable_irq();
+
+	Capture(CRASH_CAUSE_STACK_OVERFLOW, NULL, __get_PSP(), 0, task);
+
+	NVIC_SystemReset();
+}
+
+void CrashAssert(const char* file, const uint32_t line)
+{
+	const char* name = strrchr(file, '/');
+
+	__disable_irq();
+
+	// An assert inside a capture doesn't get to add to it
+	if (!captured)
+	{
+		Capture(CRASH_CAUSE_ASSERT, NULL, (__get_CONTROL() & 2) ? __get_PSP() : __get_MSP(), 0, NULL);
+
+		// Just the end of the path, that's what tells them apart
+		name = name != NULL ? name + 1 : file;
+		crashRecord->Line = line;
+		CopyString(crashRecord->File, name, sizeof(crashRecord->File));
+		Commit();
+	}
+
+	NVIC_SystemReset();
+}
+
+// HAL parameter checks, when USE_FULL_ASSERT is on
+void assert_failed(uint8_t* file, uint32_t line)
+{
+	CrashAssert((const char*)file, line);
+}
+
+// Called from the tick interrupt when the watchdog is about to bite
+// Whatever was running when the tick came in is the one not letting go
+void CrashWatchdogWarning(void)
+{
+	uint32_t* frame = (uint32_t*)__get_PSP();
+
+	Capture(CRASH_CAUSE_WATCHDOG, frame, (uint32_t)frame, 0, NULL);
+}
+
+// The watchdog got fed after all, the record stays but the next crash gets captured too
+void CrashWatchdogRecovered(void)
+{
+	captured = 0;
+}
+
+// Send the record from a task, the USB command only asks for it
+void CrashRequestReport(const uint8_t clear)
+{
+	clearRequested = clear;
+	reportRequested = 1;
+}
+
+// Empty if there's no record
+void CrashService(void)
+{
+	uint8_t header[4];
+	uint16_t crc = 0;
+	uint16_t length = 0;
+
+	if (!reportRequested)
+	{
+		return;
+	}
+
+	reportRequested = 0;
+
+	if (RecordIsValid())
+	{
+		length = sizeof(CrashRecordT);
+		crc = CrcCcitt((const uint8_t*)crashRecord, length);
+	}
+
+	header[0] = REPORT_HEADER;
+	header[1] = REPORT_IDENT;
+	header[2] = length & 0xff;
+	header[3] = (length >> 8) & 0xff;
+
+	if (UsbTransmit(header, sizeof(header))
+		&& UsbTransmit((const uint8_t*)crashRecord, length)
+		&& UsbTransmit((const uint8_t*)&crc, sizeof(crc))
+		&& clearRequested)
+	{
+		crashRecord->Magic = 0;
+	}
+}
@@ -0,0 +1,39 @@
+#ifndef CRASH_H
+#define CRASH_H
+
+#include <stdint.h>
+
+enum CRASH_CAUSE
+{
+	CRASH_CAUSE_NONE,
+	CRASH_CAUSE_HARDFAULT,
+	CRASH_CAUSE_STACK_OVERFLOW,
+	CRASH_CAUSE_ASSERT,
+	CRASH_CAUSE_WATCHDOG
+};
+
+enum CRASH_TRACE
+{
+	CRASH_TRACE_BOOT,
+	CRASH_TRACE_TX_START,
+	CRASH_TRACE_TX_END,
+	CRASH_TRACE_FLASH_ERASE,
+	CRASH_TRACE_FLASH_PROGRAM,
+	CRASH_TRACE_GPS_SLEEP,
+	CRASH_TRACE_GPS_WAKE,
+	CRASH_TRACE_BURST,
+	CRASH_TRACE_CLOCK_FAIL,
+	CRASH_TRACE_STACK_LOW
+};
+
+void CrashInit(void);
+void CrashTaskCreated(void* task);
+void CrashTrace(const uint16_t event, const uint16_t argument);
+void CrashStackOverflow(const char* task);
+void CrashAssert(const char* file, const uint32_t line);
+void CrashWatchdogWarning(void);
+void CrashWatchdogRecovered(void);
+void CrashRequestReport(const uint8_t clear);
+void CrashService(void);
+
+#endif // !CRASH_H
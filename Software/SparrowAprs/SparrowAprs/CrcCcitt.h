@@ -1,8 +1,8 @@
-#ifndef CRCCCITT_H
-#define CRCCCITT_H
-
-#include <stdint.h>
-
-uint16_t CrcCcitt(const uint8_t* data, const uint32_t length);
-
-#endif // !CRCCCITT_H
+#ifndef CRCCCITT_H
+#define CRCCCITT_H
+
+#include <stdint.h>
+
+uint16_t CrcCcitt(const uint8_t* data, const uint32_t length);
+
+#endif // !CRCCCITT_H
@@ -1,73 +1,408 @@
-#include <stm32f4xx_hal.h>
-#include <stdio.h>
-#include <string.h>
-#include "Watchdog.h"
-
-static UART_HandleTypeDef UartHandle;
-
-static uint8_t xBuffer[200];
-
-#define MAX_TIMEOUT				2000
-#define DRA818_CONNECT_LEN		15
-#define DRA818_GROUP_LEN		48
-#define DRA818_FILTER_LEN		20
-
-// PA2/PA3
-void Dra818Init(void)
-{
-	GPIO_InitTypeDef GPIO_InitStruct;
-
-	// Enable clocks
-	__GPIOA_CLK_ENABLE();
-	__USART2_CLK_ENABLE();
-	
-	// Configure GPIO
-	GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
-	GPIO_InitStruct.Pull      = GPIO_NOPULL;
-	GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_HIGH;
-	GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
-
-	// TX
-	GPIO_InitStruct.Pin       = GPIO_PIN_2;
-	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-
-	// RX
-	GPIO_InitStruct.Pin       = GPIO_PIN_3;
-	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
-	
-	// Configure the USART peripheral
-	UartHandle.Instance          = USART2;
-	UartHandle.Init.BaudRate     = 9600;
-	UartHandle.Init.WordLength   = UART_WORDLENGTH_8B;
-	UartHandle.Init.StopBits     = UART_STOPBITS_1;
-	UartHandle.Init.Parity       = UART_PARITY_NONE;
-	UartHandle.Init.HwFlowCtl    = UART_HWCONTROL_NONE;
-	UartHandle.Init.Mode         = UART_MODE_TX_RX;
-
-	// Commit the USART
-	if (HAL_UART_Init(&UartHandle) != HAL_OK)
-	{
-		while (1) ;
-	}
-}
-
-uint8_t Dra818Connect(void)
-{
-	char command[DRA818_CONNECT_LEN] = "AT+DMOCONNECT\r\n";
-	HAL_UART_Transmit(&UartHandle, (uint8_t*)command, strlen(command), MAX_TIMEOUT);
-	return 1;
-}
-
-uint8_t Dra818SetGroup(const float txFreq, const float rxFreq, const char ctcssTx[4], const char ctcssRx[4], const uint8_t squelch)
-{
-	sprintf((char*)&xBuffer, "AT+DMOSETGROUP=0,%03.4f,%03.4f,%.4s,%c,%.4s\r\n", txFreq, rxFreq, ctcssTx, squelch + '0', ctcssRx);
-	HAL_UART_Transmit(&UartHandle, xBuffer, DRA818_GROUP_LEN, MAX_TIMEOUT);
-	return 1;
-}
-
-uint8_t Dra818SetFilter(const uint8_t predeemphasis, const uint8_t highpass, const uint8_t lowpass)
-{
-	sprintf((char*)xBuffer, "AT+SETFILTER=%c,%c,%c\r\n", predeemphasis + '0', highpass + '0', lowpass + '0');
-	HAL_UART_Transmit(&UartHandle, xBuffer, DRA818_FILTER_LEN, MAX_TIMEOUT);
-	return 1;
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "timers.h"
+#include <stdio.h>
+#include <string.h>
+#include "Watchdog.h"
+#include "Clock.h"
+#include "Dra818.h"
+
+static UART_HandleTypeDef UartHandle;
+
+// AT command engine
+// Commands are queued by the caller and run back to back from the USART interrupt
+// Each one is retried until the module answers with the expected reply or we run out of attempts
+typedef struct
+{
+	char Command[64];
+	char Expect[16];
+	uint8_t Attempts;
+} Dra818CommandT;
+
+#define COMMAND_QUEUE_SIZE		4
+static Dra818CommandT commands[COMMAND_QUEUE_SIZE];
+static volatile uint32_t commandHead = 0;
+static volatile uint32_t commandCount = 0;
+
+// Set when any command since the last Dra818Wait() gave up
+static volatile uint8_t commandFailed = 0;
+
+// When the last command byte went out, so a late timeout can't cut a newer command short
+static volatile TickType_t sentTick = 0;
+
+// Transmit state
+static const char* txPtr;
+static volatile uint32_t txRemaining = 0;
+
+// The head changed while a command was still going out, send it once that one's finished
+static volatile uint8_t sendPending = 0;
+
+// Reply line being received
+static char rBuffer[32];
+static uint32_t rLength = 0;
+
+static SemaphoreHandle_t commandsDoneSemaphore;
+static TimerHandle_t responseTimer;
+
+#define RESPONSE_TIMEOUT		100
+#define COMMAND_ATTEMPTS		3
+
+// The module needs a while to boot after power down, so connect keeps trying for longer
+#define CONNECT_ATTEMPTS		10
+
+static void Dra818Send(void);
+static void Dra818ResponseTimeout(TimerHandle_t timer);
+
+// USART2 hangs off APB1
+static void Dra818ClockChanged(void)
+{
+	UartHandle.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK1Freq(), UartHandle.Init.BaudRate);
+}
+
+// PA2/PA3
+void Dra818Init(void)
+{
+	GPIO_InitTypeDef GPIO_InitStruct;
+
+	// Enable clocks
+	__GPIOA_CLK_ENABLE();
+	__USART2_CLK_ENABLE();
+	
+	// Configure GPIO
+	GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Pull      = GPIO_NOPULL;
+	GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_HIGH;
+	GPIO_InitStruct.Alternate = GPIO_AF7_USART2;
+
+	// TX
+	GPIO_InitStruct.Pin       = GPIO_PIN_2;
+	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+	// RX
+	GPIO_InitStruct.Pin       = GPIO_PIN_3;
+	HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+	
+	// Configure the USART peripheral
+	UartHandle.Instance          = USART2;
+	UartHandle.Init.BaudRate     = 9600;
+	UartHandle.Init.WordLength   = UART_WORDLENGTH_8B;
+	UartHandle.Init.StopBits     = UART_STOPBITS_1;
+	UartHandle.Init.Parity       = UART_PARITY_NONE;
+	UartHandle.Init.HwFlowCtl    = UART_HWCONTROL_NONE;
+	UartHandle.Init.Mode         = UART_MODE_TX_RX;
+
+	// Commit the USART
+	if (HAL_UART_Init(&UartHandle) != HAL_OK)
+	{
+		while (1) ;
+	}
+
+	ClockRegisterCallback(Dra818ClockChanged);
+
+	// Engine plumbing
+	commandsDoneSemaphore = xSemaphoreCreateBinary();
+	responseTimer = xTimerCreate("Dra818", RESPONSE_TIMEOUT / portTICK_PERIOD_MS, pdFALSE, NULL, Dra818ResponseTimeout);
+
+	// Replies are collected a byte at a time from the interrupt
+	__HAL_UART_ENABLE_IT(&UartHandle, UART_IT_RXNE);
+	HAL_NVIC_SetPriority(USART2_IRQn, 0xf, 0xf);
+	HAL_NVIC_EnableIRQ(USART2_IRQn);
+}
+
+// Put a command on the queue, and start it if the engine is idle
+static uint8_t Dra818Enqueue(const char* expect, const uint8_t attempts)
+{
+	Dra818CommandT* command;
+
+	taskENTER_CRITICAL();
+
+	if (commandCount >= COMMAND_QUEUE_SIZE)
+	{
+		taskEXIT_CRITICAL();
+		return 0;
+	}
+
+	command = &commands[(commandHead + commandCount) % COMMAND_QUEUE_SIZE];
+	strncpy(command->Expect, expect, sizeof(command->Expect) - 1);
+	command->Expect[sizeof(command->Expect) - 1] = 0;
+	command->Attempts = attempts;
+	commandCount++;
+
+	// Nothing in flight, kick it off
+	if (commandCount == 1)
+	{
+		Dra818Send();
+	}
+
+	taskEXIT_CRITICAL();
+
+	return 1;
+}
+
+// Format straight into the slot the command will occupy
+// Only the caller task queues commands, so the slot can't move under us
+static char* Dra818NextSlot(void)
+{
+	if (commandCount >= COMMAND_QUEUE_SIZE)
+	{
+		return NULL;
+	}
+
+	return commands[(commandHead + commandCount) % COMMAND_QUEUE_SIZE].Command;
+}
+
+uint8_t Dra818Connect(void)
+{
+	char* slot = Dra818NextSlot();
+
+	if (slot == NULL)
+	{
+		return 0;
+	}
+
+	strcpy(slot, "AT+DMOCONNECT\r\n");
+	return Dra818Enqueue("+DMOCONNECT:0", CONNECT_ATTEMPTS);
+}
+
+uint8_t Dra818SetGroup(const float txFreq, const float rxFreq, const char ctcssTx[4], const char ctcssRx[4], const uint8_t squelch)
+{
+	char* slot = Dra818NextSlot();
+
+	if (slot == NULL)
+	{
+		return 0;
+	}
+
+	snprintf(slot, sizeof(commands[0].Command), "AT+DMOSETGROUP=0,%03.4f,%03.4f,%.4s,%c,%.4s\r\n", txFreq, rxFreq, ctcssTx, squelch + '0', ctcssRx);
+	return Dra818Enqueue("+DMOSETGROUP:0", COMMAND_ATTEMPTS);
+}
+
+uint8_t Dra818SetFilter(const uint8_t predeemphasis, const uint8_t highpass, const uint8_t lowpass)
+{
+	char* slot = Dra818NextSlot();
+
+	if (slot == NULL)
+	{
+		return 0;
+	}
+
+	snprintf(slot, sizeof(commands[0].Command), "AT+SETFILTER=%c,%c,%c\r\n", predeemphasis + '0', highpass + '0', lowpass + '0');
+	return Dra818Enqueue("+DMOSETFILTER:0", COMMAND_ATTEMPTS);
+}
+
+uint8_t Dra818IsBusy(void)
+{
+	return (commandCount != 0);
+}
+
+// Block until every queued command has finished, or ticks run out
+// Returns 1 if everything queued since the last wait was acknowledged
+uint8_t Dra818Wait(const TickType_t ticks)
+{
+	uint8_t result;
+	TickType_t start = xTaskGetTickCount();
+	TickType_t elapsed;
+
+	while (Dra818IsBusy())
+	{
+		elapsed = xTaskGetTickCount() - start;
+
+		if (elapsed >= ticks || xSemaphoreTake(commandsDoneSemaphore, ticks - elapsed) != pdTRUE)
+		{
+			return 0;
+		}
+	}
+
+	taskENTER_CRITICAL();
+	result = !commandFailed;
+	commandFailed = 0;
+	taskEXIT_CRITICAL();
+
+	return result;
+}
+
+// Start transmitting the command at the head of the queue
+// Called with the queue locked, or from the interrupt
+static void Dra818Send(void)
+{
+	// Restarting mid-command would hand the module half of one and all of another
+	if (txRemaining)
+	{
+		sendPending = 1;
+		return;
+	}
+
+	txPtr = commands[commandHead].Command;
+	txRemaining = strlen(txPtr);
+	rLength = 0;
+
+	// Bytes go out from the TXE interrupt
+	__HAL_UART_ENABLE_IT(&UartHandle, UART_IT_TXE);
+}
+
+// The command at the head is done one way or the other, move on to the next
+// Returns 1 if the queue drained
+static uint8_t Dra818Complete(const uint8_t success)
+{
+	if (!success)
+	{
+		commandFailed = 1;
+	}
+
+	commandHead = (commandHead + 1) % COMMAND_QUEUE_SIZE;
+	commandCount--;
+
+	if (commandCount)
+	{
+		Dra818Send();
+		return 0;
+	}
+
+	return 1;
+}
+
+// Burn an attempt on the command at the head, resending it if it has any left
+// Returns 1 if the queue drained
+static uint8_t Dra818Retry(void)
+{
+	Dra818CommandT* command = &commands[commandHead];
+
+	if (--command->Attempts)
+	{
+		Dra818Send();
+		return 0;
+	}
+
+	return Dra818Complete(0);
+}
+
+// No reply in time. Runs in the timer task
+static void Dra818ResponseTimeout(TimerHandle_t timer)
+{
+	uint8_t drained = 0;
+	uint8_t early = 0;
+
+	taskENTER_CRITICAL();
+
+	// Only act if something has been waiting the full timeout
+	if (commandCount && !txRemaining)
+	{
+		if (xTaskGetTickCount() - sentTick >= RESPONSE_TIMEOUT / portTICK_PERIOD_MS)
+		{
+			drained = Dra818Retry();
+		}
+		else
+		{
+			early = 1;
+		}
+	}
+
+	taskEXIT_CRITICAL();
+
+	// A newer command was sent after this timer was armed, give it its full time
+	if (early)
+	{
+		xTimerReset(timer, 0);
+	}
+
+	if (drained)
+	{
+		xSemaphoreGive(commandsDoneSemaphore);
+	}
+}
+
+// A full reply line has arrived
+// Returns 1 if the queue drained
+static uint8_t Dra818HandleLine(void)
+{
+	const char* expect;
+	uint32_t length;
+
+	// Stray bytes from a module that is still booting
+	if (!commandCount || rLength == 0)
+	{
+		return 0;
+	}
+
+	rBuffer[rLength] = 0;
+	rLength = 0;
+
+	expect = commands[commandHead].Expect;
+	length = strlen(expect);
+
+	if (strncmp(rBuffer, expect, length) == 0)
+	{
+		return Dra818Complete(1);
+	}
+
+	// Our command with a non-zero status, the module refused it, try again
+	// Anything else is a late reply to an earlier command and isn't ours to act on
+	if (strncmp(rBuffer, expect, length - 1) == 0 && rBuffer[length - 1] != 0)
+	{
+		return Dra818Retry();
+	}
+
+	return 0;
+}
+
+void USART2_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint32_t sr = USART2->SR;
+	uint8_t drained = 0;
+	char c;
+
+	// Reply bytes
+	if (sr & USART_SR_RXNE)
+	{
+		c = USART2->DR;
+
+		if (c == '\n')
+		{
+			xTimerStopFromISR(responseTimer, &xHigherPriorityTaskWoken);
+			drained = Dra818HandleLine();
+		}
+		else if (c != '\r' && rLength < sizeof(rBuffer) - 1)
+		{
+			rBuffer[rLength++] = c;
+		}
+	}
+	else if (sr & (USART_SR_ORE | USART_SR_NE | USART_SR_FE | USART_SR_PE))
+	{
+		// Line noise while the module powers up, the timeout will sort it out
+		__HAL_UART_CLEAR_PEFLAG(&UartHandle);
+	}
+
+	// Command bytes
+	if ((sr & USART_SR_TXE) && (USART2->CR1 & USART_CR1_TXEIE))
+	{
+		if (txRemaining)
+		{
+			USART2->DR = *txPtr++;
+			txRemaining--;
+		}
+
+		// Last byte is in the shift register, start timing the reply
+		// Unless the head moved on while it went out, then the new head goes next
+		if (!txRemaining && sendPending)
+		{
+			sendPending = 0;
+			Dra818Send();
+		}
+		else if (!txRemaining)
+		{
+			__HAL_UART_DISABLE_IT(&UartHandle, UART_IT_TXE);
+			sentTick = xTaskGetTickCountFromISR();
+			xTimerResetFromISR(responseTimer, &xHigherPriorityTaskWoken);
+		}
+	}
+
+	if (drained)
+	{
+		xSemaphoreGiveFromISR(commandsDoneSemaphore, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
\ No newline at end of file
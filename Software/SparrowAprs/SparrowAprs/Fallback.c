@@ -1,19 +1,19 @@
-/*
-	If the board experinces continued crashes, enter CW fallback mode
-
-	In this mode, we will go to ap redefined freq and transmit for foxhunting
-
-*/
-
-void FallBackEnter(void)
-{
-	// Reconfigure clock. Us HSI so we are not reliant on the HSE
-
-	// Reconfigure radio to the fallback freq
-
-	// Transmit CW
-	while(1)
-	{
-
-	}
+/*
+	If the board experinces continued crashes, enter CW fallback mode
+
+	In this mode, we will go to ap redefined freq and transmit for foxhunting
+
+*/
+
+void FallBackEnter(void)
+{
+	// Reconfigure clock. Us HSI so we are not reliant on the HSE
+
+	// Reconfigure radio to the fallback freq
+
+	// Transmit CW
+	while(1)
+	{
+
+	}
 }
\ No newline at end of file
@@ -1,129 +1,352 @@
-#include <stm32f4xx_hal.h>
-#include <string.h>
-#include "Config.h"
-#include "FlashConfig.h"
-
-static void* Stm32f4SectorToBaseAddr(const uint32_t sector);
-
-typedef struct 
-{
-	uint8_t Sector;
-	uint32_t* Address;
-	uint32_t Size;
-} FlashSectorT;
-
-// STM32F4 FLASH Sectors table
-#define SECTOR_COUNT	12
-const FlashSectorT _Sectors[SECTOR_COUNT] = {
-	{0,  (uint32_t*)0x08000000, 16000},
-	{1,  (uint32_t*)0x08004000, 16000},
-	{2,  (uint32_t*)0x08008000, 16000},
-	{3,  (uint32_t*)0x0800C000, 16000},
-	{4,  (uint32_t*)0x08010000, 64000},
-	{5,  (uint32_t*)0x08020000, 128000},
-	{6,  (uint32_t*)0x08040000, 128000},
-	{7,  (uint32_t*)0x08060000, 128000},
-	{8,  (uint32_t*)0x08080000, 128000},
-	{9,  (uint32_t*)0x080a0000, 128000},
-	{10, (uint32_t*)0x080c0000, 128000},
-	{11, (uint32_t*)0x080e0000, 128000}
-};
-
-typedef struct
-{
-	uint32_t FlashMagic;
-	ConfigT Config;
-	uint32_t Crc;
-} FlashConfigStructureT;
-
-// Storage for the live configuration structure 
-static FlashConfigStructureT config;
-
-#define FLASH_CONFIG_MAGIC 0x51242757
-
-void FlashConfigInit(void)
-{
-	// If we can't load from flash, then just load defaults
-	if (!FlashConfigLoad())
-	{
-		ConfigLoadDefaults();
-	}
-}
-
-uint8_t FlashConfigLoad(void)
-{
-	FlashConfigStructureT* storedStruct = Stm32f4SectorToBaseAddr(FLASH_CONFIG_SECTOR);
-
-	if (storedStruct->FlashMagic != FLASH_CONFIG_MAGIC)
-	{
-		return 0;
-	}
-
-	memcpy(&config, &storedStruct->Config, sizeof(ConfigT));
-
-	return 1;
-}
-
-void FlashConfigLoadFromMemory(const ConfigT* configIn)
-{
-	memcpy(&config.Config, configIn, sizeof(ConfigT));
-}
-
-// Save config to flash
-uint8_t FlashConfigSave(void)
-{
-	uint32_t i = 0;
-	uint32_t* addrPtr = Stm32f4SectorToBaseAddr(FLASH_CONFIG_SECTOR);
-
-	// Unlock FLASH
-	HAL_FLASH_Unlock();
-
-	// Program the structure
-	for(i = 0 ; i < sizeof(FlashConfigStructureT) ; i++)
-	{
-		HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, *addrPtr++, *(uint64_t*)(&config) + i);
-	}
-
-	// Lock FLASH
-	HAL_FLASH_Lock();
-
-	return 1;
-}
-
-uint32_t GetLatestFreeConfigAddress(void)
-{
-	return 0;
-}
-
-// Get the latest flash config structure
-uint32_t GetLatestConfigStructure(void)
-{
-	uint32_t* addrPtr = Stm32f4SectorToBaseAddr(FLASH_CONFIG_SECTOR);
-	uint8_t doneFinding = 1;
-
-	while (!doneFinding)
-	{
-		// Conjure the address as a 
-
-	}
-
-
-	return 0;
-}
-
-// Get the base address of a sector
-static void* Stm32f4SectorToBaseAddr(const uint32_t sector)
-{
-	if (sector >= SECTOR_COUNT)
-	{
-		return 0;
-	}
-
-	return _Sectors[sector].Address;
-}
-
-// Get pointer to the live configuration struct in memory
-ConfigT* FlashConfigGetPtr(void)
-{
-	return &config.Config;
-}
+/*
+	Flash configuration store
+
+	A sector erase is 128KB and stalls the core for a second or two, and the
+	sector is only good for 10k of them. So configuration is a log instead:
+	each save appends a versioned, CRC'd record to the active sector and the
+	newest good record wins. Only when the active sector fills is the newest
+	record copied into the other one, which is the only time we erase.
+
+	Sector layout:
+
+		SectorHeaderT		written last, when the sector takes over
+		ConfigRecordT[]		fixed size slots, filled in order
+
+	Records are programmed body first and magic last, so a save cut short by
+	a reset leaves a slot that is used but not valid. Slots fill in order, so
+	the end of the log is found with a binary search for the first blank slot
+	and the newest record is at most a few torn slots back from there.
+*/
+
+#include <stm32f4xx_hal.h>
+#include <string.h>
+#include "Config.h"
+#include "CrcCcitt.h"
+#include "FlashConfig.h"
+#include "FlashJob.h"
+
+static void* Stm32f4SectorToBaseAddr(const uint32_t sector);
+
+typedef struct
+{
+	uint8_t Sector;
+	uint32_t* Address;
+	uint32_t Size;
+} FlashSectorT;
+
+// STM32F4 FLASH Sectors table
+#define SECTOR_COUNT	12
+const FlashSectorT _Sectors[SECTOR_COUNT] = {
+	{0,  (uint32_t*)0x08000000, 0x4000},
+	{1,  (uint32_t*)0x08004000, 0x4000},
+	{2,  (uint32_t*)0x08008000, 0x4000},
+	{3,  (uint32_t*)0x0800C000, 0x4000},
+	{4,  (uint32_t*)0x08010000, 0x10000},
+	{5,  (uint32_t*)0x08020000, 0x20000},
+	{6,  (uint32_t*)0x08040000, 0x20000},
+	{7,  (uint32_t*)0x08060000, 0x20000},
+	{8,  (uint32_t*)0x08080000, 0x20000},
+	{9,  (uint32_t*)0x080a0000, 0x20000},
+	{10, (uint32_t*)0x080c0000, 0x20000},
+	{11, (uint32_t*)0x080e0000, 0x20000}
+};
+
+#define SECTOR_MAGIC			0xC0F15EC7
+#define RECORD_MAGIC			0x51242757
+#define ERASED_WORD				0xFFFFFFFF
+
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t Generation;
+} SectorHeaderT;
+
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint16_t Length;
+	uint16_t Crc;
+	ConfigT Config;
+} ConfigRecordT;
+
+#define RECORD_WORDS			(sizeof(ConfigRecordT) / sizeof(uint32_t))
+
+// How far back from the end of the log to look for an intact record
+#define MAX_TORN_RECORDS		4
+
+// Slots to try before giving up on the active sector and compacting
+#define MAX_PROGRAM_RETRIES		3
+
+// The two sectors we swap between
+static const uint32_t storeSectors[2] = { FLASH_CONFIG_SECTOR, FLASH_CONFIG_SPARE_SECTOR };
+
+// Storage for the live configuration structure
+static ConfigT config;
+
+// Where the log is up to
+static uint8_t haveActive = 0;
+static uint32_t activeIndex;
+static uint32_t activeGeneration;
+static uint32_t nextSlot;
+static uint32_t version = 0;
+
+static SectorHeaderT* SectorHeader(const uint32_t index)
+{
+	return Stm32f4SectorToBaseAddr(storeSectors[index]);
+}
+
+static ConfigRecordT* SectorSlot(const uint32_t index, const uint32_t slot)
+{
+	return (ConfigRecordT*)((uint8_t*)SectorHeader(index) + sizeof(SectorHeaderT)) + slot;
+}
+
+static uint32_t SectorSlotCount(const uint32_t index)
+{
+	return (_Sectors[storeSectors[index]].Size - sizeof(SectorHeaderT)) / sizeof(ConfigRecordT);
+}
+
+static uint16_t RecordCrc(const ConfigRecordT* record)
+{
+	// Everything after the CRC, plus the version so a record can't be replayed under another
+	return CrcCcitt((const uint8_t*)&record->Version, sizeof(record->Version))
+		^ CrcCcitt((const uint8_t*)&record->Config, sizeof(record->Config));
+}
+
+static uint8_t SlotIsBlank(const ConfigRecordT* slot)
+{
+	const uint32_t* word = (const uint32_t*)slot;
+	uint32_t i;
+
+	for (i = 0; i < RECORD_WORDS; i++)
+	{
+		if (word[i] != ERASED_WORD)
+		{
+			return 0;
+		}
+	}
+
+	return 1;
+}
+
+static uint8_t RecordIsValid(const ConfigRecordT* record)
+{
+	return record->Magic == RECORD_MAGIC
+		&& record->Length == sizeof(ConfigT)
+		&& record->Crc == RecordCrc(record);
+}
+
+// First blank slot, every slot before it has been written
+static uint32_t FindEnd(const uint32_t index)
+{
+	uint32_t low = 0;
+	uint32_t high = SectorSlotCount(index);
+	uint32_t middle;
+
+	while (low < high)
+	{
+		middle = (low + high) / 2;
+
+		if (SlotIsBlank(SectorSlot(index, middle)))
+		{
+			high = middle;
+		}
+		else
+		{
+			low = middle + 1;
+		}
+	}
+
+	return low;
+}
+
+// Newest intact record in a sector, NULL if there isn't one near the end
+static const ConfigRecordT* FindNewest(const uint32_t index, const uint32_t end)
+{
+	uint32_t slot = end;
+
+	while (slot > 0 && end - slot < MAX_TORN_RECORDS)
+	{
+		slot--;
+
+		if (RecordIsValid(SectorSlot(index, slot)))
+		{
+			return SectorSlot(index, slot);
+		}
+	}
+
+	return NULL;
+}
+
+// Generations wrap, newer is whichever is ahead by less than half the range
+static uint8_t GenerationIsNewer(const uint32_t a, const uint32_t b)
+{
+	return (int32_t)(a - b) > 0;
+}
+
+static uint8_t ProgramWord(uint32_t* address, const uint32_t data)
+{
+	return FlashJobProgram(address, &data, sizeof(data));
+}
+
+// Write a record into a blank slot, magic last
+static uint8_t ProgramRecord(ConfigRecordT* slot, const ConfigRecordT* record)
+{
+	uint32_t* destination = (uint32_t*)slot;
+	const uint32_t* source = (const uint32_t*)record;
+
+	return FlashJobProgram(destination + 1, source + 1, sizeof(ConfigRecordT) - sizeof(uint32_t))
+		&& ProgramWord(destination, source[0]);
+}
+
+static uint8_t EraseSector(const uint32_t index)
+{
+	return FlashJobErase(storeSectors[index]);
+}
+
+// Start the other sector with just this record in it
+// The old sector stays authoritative until the new header is down
+static uint8_t Compact(const ConfigRecordT* record)
+{
+	uint32_t index = haveActive ? activeIndex ^ 1 : 0;
+	uint32_t generation = haveActive ? activeGeneration + 1 : 1;
+	SectorHeaderT* header = SectorHeader(index);
+
+	if (!EraseSector(index) || !ProgramRecord(SectorSlot(index, 0), record))
+	{
+		return 0;
+	}
+
+	if (!ProgramWord(&header->Generation, generation) || !ProgramWord(&header->Magic, SECTOR_MAGIC))
+	{
+		return 0;
+	}
+
+	haveActive = 1;
+	activeIndex = index;
+	activeGeneration = generation;
+	nextSlot = 1;
+
+	return 1;
+}
+
+void FlashConfigInit(void)
+{
+	// If we can't load from flash, then just load defaults
+	if (!FlashConfigLoad())
+	{
+		ConfigLoadDefaults();
+	}
+}
+
+uint8_t FlashConfigLoad(void)
+{
+	const ConfigRecordT* newest = NULL;
+	const SectorHeaderT* header;
+	uint32_t order[2];
+	uint32_t end;
+	uint32_t i;
+
+	haveActive = 0;
+
+	// Newest sector first, fall back to the other if it never got a record down
+	order[0] = 0;
+	order[1] = 1;
+
+	if (SectorHeader(1)->Magic == SECTOR_MAGIC
+		&& (SectorHeader(0)->Magic != SECTOR_MAGIC || GenerationIsNewer(SectorHeader(1)->Generation, SectorHeader(0)->Generation)))
+	{
+		order[0] = 1;
+		order[1] = 0;
+	}
+
+	for (i = 0; i < 2 && newest == NULL; i++)
+	{
+		header = SectorHeader(order[i]);
+
+		if (header->Magic != SECTOR_MAGIC)
+		{
+			continue;
+		}
+
+		end = FindEnd(order[i]);
+		newest = FindNewest(order[i], end);
+
+		// Appends go to the newest sector, even if its only record is torn
+		if (!haveActive)
+		{
+			haveActive = 1;
+			activeIndex = order[i];
+			activeGeneration = header->Generation;
+			nextSlot = end;
+		}
+	}
+
+	if (newest == NULL)
+	{
+		return 0;
+	}
+
+	version = newest->Version;
+	memcpy(&config, &newest->Config, sizeof(ConfigT));
+
+	return 1;
+}
+
+void FlashConfigLoadFromMemory(const ConfigT* configIn)
+{
+	memcpy(&config, configIn, sizeof(ConfigT));
+}
+
+// Append the live config to the log
+uint8_t FlashConfigSave(void)
+{
+	ConfigRecordT record;
+	uint32_t attempts = 0;
+	uint8_t saved = 0;
+
+	memset(&record, 0, sizeof(record));
+	record.Magic = RECORD_MAGIC;
+	record.Version = version + 1;
+	record.Length = sizeof(ConfigT);
+	memcpy(&record.Config, &config, sizeof(ConfigT));
+	record.Crc = RecordCrc(&record);
+
+	// A slot that won't take the record is skipped, it's used now either way
+	while (haveActive && !saved && attempts < MAX_PROGRAM_RETRIES && nextSlot < SectorSlotCount(activeIndex))
+	{
+		saved = ProgramRecord(SectorSlot(activeIndex, nextSlot), &record);
+		nextSlot++;
+		attempts++;
+	}
+
+	// Full, damaged or never set up
+	if (!saved)
+	{
+		saved = Compact(&record);
+	}
+
+	if (saved)
+	{
+		version = record.Version;
+	}
+
+	return saved;
+}
+
+// Get the base address of a sector
+static void* Stm32f4SectorToBaseAddr(const uint32_t sector)
+{
+	if (sector >= SECTOR_COUNT)
+	{
+		return 0;
+	}
+
+	return _Sectors[sector].Address;
+}
+
+// Get pointer to the live configuration struct in memory
+ConfigT* FlashConfigGetPtr(void)
+{
+	return &config;
+}
@@ -0,0 +1,338 @@
+/*
+	Flash job scheduler
+
+	The F407 has one flash bank and everything runs from it. While a program
+	or erase is in progress any fetch from flash stalls, every task and every
+	interrupt, until it's done. A byte program is tens of microseconds, a
+	128KB sector erase is one to two seconds.
+
+	So nothing touches flash directly. Erases and programs are queued here and
+	run from this task when it's safe:
+
+		- Nobody holds us off. The radio holds from wakeup until it powers
+		  down, so the DAC and ADC DMA never wait on a stalled interrupt.
+		- For erases, the GPS is asleep, or a fix has just come through the
+		  hub and the NMEA ring has been drained. If the GPS never sleeps we
+		  only wait so long for that.
+
+	Programs are split into chunks and the window is checked again between
+	them. The loops that drive the flash controller run from RAM, so this task
+	doesn't stall itself waiting on BSY.
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include <string.h>
+#include "Audio.h"
+#include "GpsHub.h"
+#include "GpsDuty.h"
+#include "Crash.h"
+#include "FlashJob.h"
+
+// Copied into RAM with .data by the startup code
+// long_call because RAM is further away than a branch can reach
+#define RAM_FUNCTION			__attribute__((section(".data.ramfunc"), long_call, noinline))
+
+#define FLASH_JOB_ERASE			0
+#define FLASH_JOB_PROGRAM		1
+
+typedef struct
+{
+	uint8_t Type;
+	uint32_t Sector;
+	uint8_t* Address;
+	const uint8_t* Data;
+	uint32_t Length;
+	TaskHandle_t Owner;
+	volatile uint8_t* Result;
+} FlashJobT;
+
+#define JOB_QUEUE_SIZE			8
+
+// Bytes programmed before checking the window again, ~5ms of stalls at most
+#define CHUNK_SIZE				256
+
+// A fix this fresh means the NMEA ring has just been emptied
+#define FIX_WINDOW				100
+
+// Give up waiting for a quiet GPS after this long
+#define MAX_ERASE_DEFER			60000
+
+#define FLASH_SR_ERRORS			(FLASH_SR_PGSERR | FLASH_SR_PGPERR | FLASH_SR_PGAERR | FLASH_SR_WRPERR | FLASH_SR_SOP)
+
+static QueueHandle_t jobQueue;
+static volatile uint32_t holds = 0;
+
+static void FlashJobTask(void* pvParameters);
+static TaskHandle_t flashJobTaskHandle = NULL;
+
+void FlashJobInit(void)
+{
+	jobQueue = xQueueCreate(JOB_QUEUE_SIZE, sizeof(FlashJobT));
+}
+
+void FlashJobStartTask(void)
+{
+	// Create task
+	// Just under the radio, once a window opens we want it used
+	xTaskCreate(FlashJobTask,
+		"FlashJob",
+		200,
+		NULL,
+		6,
+		&flashJobTaskHandle);
+
+	// Woken by the hub on new fixes, for the erase window
+	GpsHubSubscribe(flashJobTaskHandle);
+}
+
+// Keep flash jobs from starting until released
+void FlashJobHold(const uint32_t hold)
+{
+	taskENTER_CRITICAL();
+	holds |= hold;
+	taskEXIT_CRITICAL();
+}
+
+void FlashJobRelease(const uint32_t hold)
+{
+	taskENTER_CRITICAL();
+	holds &= ~hold;
+	taskEXIT_CRITICAL();
+
+	if (flashJobTaskHandle != NULL)
+	{
+		xTaskNotify(flashJobTaskHandle, FLASH_JOB_NOTIFY_WINDOW, eSetBits);
+	}
+}
+
+// Program bytes, a word at a time where alignment allows
+// Runs from RAM, nothing in here may call out to flash
+RAM_FUNCTION static uint32_t ProgramChunk(uint8_t* address, const uint8_t* data, uint32_t length)
+{
+	FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;
+
+	while (length > 0 && !(FLASH->SR & FLASH_SR_ERRORS))
+	{
+		FLASH->CR &= ~FLASH_CR_PSIZE;
+
+		if (((uint32_t)address & 3) == 0 && ((uint32_t)data & 3) == 0 && length >= 4)
+		{
+			FLASH->CR |= FLASH_PSIZE_WORD | FLASH_CR_PG;
+			*(volatile uint32_t*)address = *(const uint32_t*)data;
+			address += 4;
+			data += 4;
+			length -= 4;
+		}
+		else
+		{
+			FLASH->CR |= FLASH_PSIZE_BYTE | FLASH_CR_PG;
+			*(volatile uint8_t*)address = *data;
+			address++;
+			data++;
+			length--;
+		}
+
+		__DSB();
+
+		while (FLASH->SR & FLASH_SR_BSY)
+		{
+		}
+	}
+
+	FLASH->CR &= ~FLASH_CR_PG;
+
+	return FLASH->SR & FLASH_SR_ERRORS;
+}
+
+// Runs from RAM, waiting out the erase here instead of stalled on a fetch
+RAM_FUNCTION static uint32_t EraseSector(const uint32_t sector)
+{
+	FLASH->SR = FLASH_SR_ERRORS | FLASH_SR_EOP;
+
+	FLASH->CR &= ~(FLASH_CR_PSIZE | FLASH_CR_SNB);
+	FLASH->CR |= FLASH_PSIZE_WORD | FLASH_CR_SER | ((sector * FLASH_CR_SNB_0) & FLASH_CR_SNB);
+	FLASH->CR |= FLASH_CR_STRT;
+
+	__DSB();
+
+	while (FLASH->SR & FLASH_SR_BSY)
+	{
+	}
+
+	FLASH->CR &= ~(FLASH_CR_SER | FLASH_CR_SNB);
+
+	return FLASH->SR & FLASH_SR_ERRORS;
+}
+
+static uint8_t RunProgram(uint8_t* address, const uint8_t* data, const uint32_t length)
+{
+	uint32_t errors;
+
+	HAL_FLASH_Unlock();
+	errors = ProgramChunk(address, data, length);
+	HAL_FLASH_Lock();
+
+	// Check it took, a bit that was already 0 can't be set back to 1
+	return !errors && memcmp(address, data, length) == 0;
+}
+
+static uint8_t RunErase(const uint32_t sector)
+{
+	uint32_t errors;
+
+	HAL_FLASH_Unlock();
+	errors = EraseSector(sector);
+	HAL_FLASH_Lock();
+
+	return !errors;
+}
+
+static uint8_t WindowIsOpen(void)
+{
+	return holds == 0 && !AudioIsPlaying() && !AudioIsRecording();
+}
+
+static uint8_t GpsIsQuiet(void)
+{
+	SituationInfoT situation;
+
+	if (GpsDutyIsAsleep())
+	{
+		return 1;
+	}
+
+	return GpsHubGetSituation(&situation) && xTaskGetTickCount() - situation.Timestamp < FIX_WINDOW;
+}
+
+// Block until the window is open, or the GPS as well for an erase
+// Returns with the scheduler suspended so nobody can take a hold until the job has started
+static void WaitWindow(const uint8_t erase)
+{
+	TickType_t since = xTaskGetTickCount();
+
+	while (1)
+	{
+		vTaskSuspendAll();
+
+		if (WindowIsOpen() && (!erase || GpsIsQuiet() || xTaskGetTickCount() - since > MAX_ERASE_DEFER))
+		{
+			return;
+		}
+
+		xTaskResumeAll();
+
+		// Woken by a release or a fix, check now and then in case audio finished on its own
+		xTaskNotifyWait(0, FLASH_JOB_NOTIFY_WINDOW | GPS_HUB_NOTIFY_FIX, NULL, FIX_WINDOW / portTICK_PERIOD_MS);
+	}
+}
+
+static uint8_t RunJob(const FlashJobT* job)
+{
+	uint32_t done = 0;
+	uint32_t length;
+	uint8_t result;
+
+	if (job->Type == FLASH_JOB_ERASE)
+	{
+		CrashTrace(CRASH_TRACE_FLASH_ERASE, job->Sector);
+		WaitWindow(1);
+		result = RunErase(job->Sector);
+		xTaskResumeAll();
+
+		return result;
+	}
+
+	CrashTrace(CRASH_TRACE_FLASH_PROGRAM, job->Length);
+
+	// A chunk at a time, anyone who needs the bus back gets it between chunks
+	do
+	{
+		length = job->Length - done;
+
+		if (length > CHUNK_SIZE)
+		{
+			length = CHUNK_SIZE;
+		}
+
+		// Still suspended, so the radio can't key up between the check and the chunk
+		WaitWindow(0);
+		result = RunProgram(job->Address + done, job->Data + done, length);
+		xTaskResumeAll();
+
+		done += length;
+	} while (result && done < job->Length);
+
+	return result;
+}
+
+// Queue a job and wait for it, or just do it if the scheduler isn't up yet
+static uint8_t Submit(FlashJobT* job)
+{
+	volatile uint8_t result = 0;
+	uint32_t notification = 0;
+
+	if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+	{
+		return job->Type == FLASH_JOB_ERASE ? RunErase(job->Sector) : RunProgram(job->Address, job->Data, job->Length);
+	}
+
+	job->Owner = xTaskGetCurrentTaskHandle();
+	job->Result = &result;
+
+	if (xQueueSendToBack(jobQueue, job, portMAX_DELAY) != pdTRUE)
+	{
+		return 0;
+	}
+
+	// Other notifications can come in while we wait, only ours ends it
+	while (!(notification & FLASH_JOB_NOTIFY_DONE))
+	{
+		xTaskNotifyWait(0, FLASH_JOB_NOTIFY_DONE, &notification, portMAX_DELAY);
+	}
+
+	return result;
+}
+
+// Erase a sector, blocks until it's done
+uint8_t FlashJobErase(const uint32_t sector)
+{
+	FlashJobT job;
+
+	job.Type = FLASH_JOB_ERASE;
+	job.Sector = sector;
+
+	return Submit(&job);
+}
+
+// Program and verify, blocks until it's done
+// The data has to stay put until then, it isn't copied
+uint8_t FlashJobProgram(void* address, const void* data, const uint32_t length)
+{
+	FlashJobT job;
+
+	job.Type = FLASH_JOB_PROGRAM;
+	job.Address = address;
+	job.Data = data;
+	job.Length = length;
+
+	return Submit(&job);
+}
+
+static void FlashJobTask(void* pvParameters)
+{
+	FlashJobT job;
+
+	while (1)
+	{
+		if (xQueueReceive(jobQueue, &job, portMAX_DELAY) != pdTRUE)
+		{
+			continue;
+		}
+
+		*job.Result = RunJob(&job);
+		xTaskNotify(job.Owner, FLASH_JOB_NOTIFY_DONE, eSetBits);
+	}
+}
@@ -0,0 +1,19 @@
+#ifndef FLASHJOB_H
+#define FLASHJOB_H
+
+#include <stdint.h>
+
+#define FLASH_JOB_NOTIFY_DONE		(1UL << 31)
+#define FLASH_JOB_NOTIFY_WINDOW		(1UL << 30)
+
+// Anything that can't take a flash stall holds one of these
+#define FLASH_JOB_HOLD_RADIO		(1 << 0)
+
+void FlashJobInit(void);
+void FlashJobStartTask(void);
+void FlashJobHold(const uint32_t hold);
+void FlashJobRelease(const uint32_t hold);
+uint8_t FlashJobErase(const uint32_t sector);
+uint8_t FlashJobProgram(void* address, const void* data, const uint32_t length);
+
+#endif // !FLASHJOB_H
@@ -0,0 +1,297 @@
+/*
+	GPS aiding persistence
+
+	A cold receiver needs ~30s of clean sky just to pull ephemeris off the air, and
+	it starts that from scratch after every brownout. We keep what it needs for a
+	warm start somewhere that survives a reset:
+
+		* Last fix and its timestamp in RTC backup registers DR2-DR6
+		* The receiver's own navigation database (MGA-DBD dump) in backup SRAM
+
+	Both sit in the VBAT domain, so unlike flash they cost nothing to update and
+	don't stall the core with an erase. At boot the RTC time, last fix and
+	database are pushed back as MGA-INI-TIME_UTC, MGA-INI-POS_LLH and MGA-DBD.
+
+	UBX-13003221 - R15, MGA-DBD page 137, MGA-INI page 141
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#include <time.h>
+#include "Rtc.h"
+#include "CrcCcitt.h"
+#include "UbloxNeo.h"
+#include "GpsAiding.h"
+
+// Last fix, RTC_BKP_DR1 belongs to the RTC time good flag
+#define FIX_MAGIC_REG			RTC_BKP_DR2
+#define FIX_LAT_REG				RTC_BKP_DR3
+#define FIX_LON_REG				RTC_BKP_DR4
+#define FIX_ALTITUDE_REG		RTC_BKP_DR5
+#define FIX_TIMESTAMP_REG		RTC_BKP_DR6
+#define FIX_MAGIC				0x6A1D0F1C
+
+// Database store at the start of backup SRAM
+// The top 1KB of the 4KB is left alone for crash records
+#define STORE_SIZE				3072
+#define STORE_MAGIC				0xDB5A17E5
+
+typedef struct
+{
+	uint32_t Magic;
+	uint16_t Length;
+	uint16_t Crc;
+	uint8_t Data[STORE_SIZE - 8];
+} AidingStoreT;
+
+#define aidingStore				((AidingStoreT*)BKPSRAM_BASE)
+
+// How often to refresh the database once we have a fix, ephemeris is good for ~4 hours
+#define SAVE_PERIOD				(20 * 60 * 1000)
+
+// The receiver dumps its whole database in one go, this is plenty at 115200
+#define CAPTURE_TIME			2000
+
+// The receiver has a small input buffer, don't flood it with database records
+#define REPLAY_PACING			10
+
+// MGA-INI message types
+#define MGA_INI_POS_LLH			0x01
+#define MGA_INI_TIME_UTC		0x10
+#define MGA_INI_LEAP_UNKNOWN	0x80
+
+// Accuracy we claim for the RTC time, the LSI is not much of a clock
+#define TIME_ACCURACY_S			10
+
+// Accuracy we claim for the stored position, grows with its age
+// Jet stream winds can carry a balloon at 50m/s
+#define POSITION_ACCURACY_MIN	100000
+#define POSITION_ACCURACY_MAX	100000000
+#define POSITION_DRIFT_CM_S		5000
+
+static volatile uint8_t capturing = 0;
+static TickType_t captureStart;
+static TickType_t lastSave;
+static uint8_t saved = 0;
+
+static void PutU2(uint8_t* buffer, const uint16_t x)
+{
+	buffer[0] = x & 0xff;
+	buffer[1] = (x >> 8) & 0xff;
+}
+
+static void PutU4(uint8_t* buffer, const uint32_t x)
+{
+	PutU2(buffer, x & 0xffff);
+	PutU2(buffer + 2, (x >> 16) & 0xffff);
+}
+
+void GpsAidingInit(void)
+{
+	// Backup SRAM only holds its contents on VBAT with the backup regulator on
+	__HAL_RCC_BKPSRAM_CLK_ENABLE();
+	HAL_PWR_EnableBkUpAccess();
+	HAL_PWREx_EnableBkUpReg();
+
+	// Anything that doesn't check out is garbage from a cold power up
+	if (aidingStore->Magic != STORE_MAGIC
+		|| aidingStore->Length > sizeof(aidingStore->Data)
+		|| CrcCcitt(aidingStore->Data, aidingStore->Length) != aidingStore->Crc)
+	{
+		aidingStore->Magic = 0;
+		aidingStore->Length = 0;
+	}
+}
+
+// Keep the last good fix, cheap enough to do on every solution
+void GpsAidingStoreFix(const int32_t lat, const int32_t lon, const int32_t altitude)
+{
+	// Invalidate first, a reset half way through must not leave a mixed fix
+	RtcBackupWrite(FIX_MAGIC_REG, 0);
+	RtcBackupWrite(FIX_LAT_REG, (uint32_t)lat);
+	RtcBackupWrite(FIX_LON_REG, (uint32_t)lon);
+	RtcBackupWrite(FIX_ALTITUDE_REG, (uint32_t)altitude);
+	RtcBackupWrite(FIX_TIMESTAMP_REG, RtcGet());
+	RtcBackupWrite(FIX_MAGIC_REG, FIX_MAGIC);
+}
+
+// Get the last stored fix, lat/lon in 1e-7 degrees, altitude in mm
+// Returns 0 if there isn't one
+uint8_t GpsAidingGetLastFix(int32_t* lat, int32_t* lon, int32_t* altitude)
+{
+	if (RtcBackupRead(FIX_MAGIC_REG) != FIX_MAGIC)
+	{
+		return 0;
+	}
+
+	*lat = (int32_t)RtcBackupRead(FIX_LAT_REG);
+	*lon = (int32_t)RtcBackupRead(FIX_LON_REG);
+	*altitude = (int32_t)RtcBackupRead(FIX_ALTITUDE_REG);
+
+	return 1;
+}
+
+static void RestoreTime(const uint32_t now)
+{
+	uint8_t payload[24];
+	time_t t = now;
+	struct tm* utc = gmtime(&t);
+
+	memset(payload, 0, sizeof(payload));
+	payload[0] = MGA_INI_TIME_UTC;
+	payload[3] = MGA_INI_LEAP_UNKNOWN;
+	PutU2(payload + 4, utc->tm_year + 1900);
+	payload[6] = utc->tm_mon + 1;
+	payload[7] = utc->tm_mday;
+	payload[8] = utc->tm_hour;
+	payload[9] = utc->tm_min;
+	payload[10] = utc->tm_sec;
+	PutU2(payload + 16, TIME_ACCURACY_S);
+
+	UbloxNeoSendUbx(UBX_CLASS_MGA, UBX_ID_MGA_INI, payload, sizeof(payload));
+}
+
+static void RestorePosition(const uint32_t now)
+{
+	uint8_t payload[20];
+	int32_t lat;
+	int32_t lon;
+	int32_t altitude;
+	uint32_t fixTime;
+	uint32_t accuracy = POSITION_ACCURACY_MAX;
+
+	if (!GpsAidingGetLastFix(&lat, &lon, &altitude))
+	{
+		return;
+	}
+
+	// Only trust the position as much as its age allows
+	fixTime = RtcBackupRead(FIX_TIMESTAMP_REG);
+
+	if (now != 0 && fixTime != 0 && now >= fixTime
+		&& now - fixTime < (POSITION_ACCURACY_MAX - POSITION_ACCURACY_MIN) / POSITION_DRIFT_CM_S)
+	{
+		accuracy = POSITION_ACCURACY_MIN + (now - fixTime) * POSITION_DRIFT_CM_S;
+	}
+
+	memset(payload, 0, sizeof(payload));
+	payload[0] = MGA_INI_POS_LLH;
+	PutU4(payload + 4, (uint32_t)lat);
+	PutU4(payload + 8, (uint32_t)lon);
+	PutU4(payload + 12, (uint32_t)(altitude / 10));
+	PutU4(payload + 16, accuracy);
+
+	UbloxNeoSendUbx(UBX_CLASS_MGA, UBX_ID_MGA_INI, payload, sizeof(payload));
+}
+
+// Replay the stored database records exactly as the receiver gave them to us
+static void RestoreDatabase(void)
+{
+	uint32_t offset = 0;
+	uint32_t length;
+	const uint8_t* frame;
+
+	if (aidingStore->Magic != STORE_MAGIC)
+	{
+		return;
+	}
+
+	while (offset + UBX_HEADER_SIZE <= aidingStore->Length)
+	{
+		frame = aidingStore->Data + offset;
+		length = frame[2] | (frame[3] << 8);
+
+		if (offset + UBX_HEADER_SIZE + length > aidingStore->Length)
+		{
+			break;
+		}
+
+		UbloxNeoSendUbx(frame[0], frame[1], frame + UBX_HEADER_SIZE, length);
+		vTaskDelay(REPLAY_PACING);
+
+		offset += UBX_HEADER_SIZE + length;
+	}
+}
+
+// Push everything we know to the receiver
+// Must be called once the link is configured
+void GpsAidingRestore(void)
+{
+	uint32_t now = RtcGet();
+
+	// Time first, the receiver ignores position and ephemeris without it
+	if (now != 0)
+	{
+		RestoreTime(now);
+	}
+
+	RestorePosition(now);
+	RestoreDatabase();
+}
+
+// Collect MGA-DBD records while a capture is running
+// Called from the NMEA task with a frame starting at the class byte
+void GpsAidingCaptureFrame(const uint8_t* frame, const uint32_t length)
+{
+	if (!capturing)
+	{
+		return;
+	}
+
+	// Keep whatever fits, each record stands alone
+	if (aidingStore->Length + length > sizeof(aidingStore->Data))
+	{
+		return;
+	}
+
+	memcpy(aidingStore->Data + aidingStore->Length, frame, length);
+	aidingStore->Length += length;
+}
+
+uint8_t GpsAidingIsCapturing(void)
+{
+	return capturing;
+}
+
+// Poll for a fresh database now and then, and seal the store once the dump is over
+void GpsAidingService(const uint8_t haveFix)
+{
+	TickType_t timeNow = xTaskGetTickCount();
+	uint8_t poll = 0;
+
+	if (capturing)
+	{
+		if (timeNow - captureStart > CAPTURE_TIME)
+		{
+			capturing = 0;
+
+			// Nothing came back, leave the store empty
+			if (aidingStore->Length != 0)
+			{
+				aidingStore->Crc = CrcCcitt(aidingStore->Data, aidingStore->Length);
+				aidingStore->Magic = STORE_MAGIC;
+			}
+		}
+
+		return;
+	}
+
+	// Nothing worth saving until the receiver has navigated
+	if (!haveFix || (saved && timeNow - lastSave < SAVE_PERIOD))
+	{
+		return;
+	}
+
+	saved = 1;
+	lastSave = timeNow;
+
+	// The old dump is overwritten in place, so it's invalid from here on
+	aidingStore->Magic = 0;
+	aidingStore->Length = 0;
+	captureStart = timeNow;
+	capturing = 1;
+
+	UbloxNeoSendUbx(UBX_CLASS_MGA, UBX_ID_MGA_DBD, &poll, 0);
+}
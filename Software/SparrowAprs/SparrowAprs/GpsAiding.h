@@ -0,0 +1,14 @@
+#ifndef GPSAIDING_H
+#define GPSAIDING_H
+
+#include <stdint.h>
+
+void GpsAidingInit(void);
+void GpsAidingRestore(void);
+void GpsAidingService(const uint8_t haveFix);
+uint8_t GpsAidingIsCapturing(void);
+void GpsAidingCaptureFrame(const uint8_t* frame, const uint32_t length);
+void GpsAidingStoreFix(const int32_t lat, const int32_t lon, const int32_t altitude);
+uint8_t GpsAidingGetLastFix(int32_t* lat, int32_t* lon, int32_t* altitude);
+
+#endif // !GPSAIDING_H
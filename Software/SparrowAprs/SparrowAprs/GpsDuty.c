@@ -0,0 +1,143 @@
+/*
+	GPS duty cycling
+
+	The receiver is one of the biggest loads on a long float, and in continuous
+	mode it's computing 5 solutions a second that nobody looks at. Between
+	beacons we put it into software backup and wake it again just early enough
+	for a hot start to settle before the next beacon wants a position.
+
+	BeaconTask tells us when it next needs a fix, and whether the flight phase
+	needs the receiver running all the time (descent). Anything we're not sure
+	about keeps it awake: no fix yet, fix not settled, beacon too close.
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "LowPower.h"
+#include "UbloxNeo.h"
+#include "Crash.h"
+#include "GpsDuty.h"
+
+// How long before the beacon to wake, a hot start is a few seconds and we want a settled fix
+#define GPS_WAKE_LEAD			15000
+
+// Not worth a backup/restart cycle for less than this
+#define GPS_SLEEP_MIN			20000
+
+// Fix must be held this long before sleeping, lets the receiver catch up on ephemeris
+#define GPS_SETTLE_TIME			10000
+
+static volatile TickType_t fixDeadline;
+static volatile uint8_t scheduled = 0;
+static volatile uint8_t continuous = 1;
+
+static uint8_t asleep = 0;
+static TickType_t wakeTime;
+static TickType_t fixSince;
+static uint8_t fixHeld = 0;
+
+// Called by BeaconTask with the tick it next needs a fix by
+void GpsDutySchedule(const TickType_t deadline, const uint8_t needContinuous)
+{
+	taskENTER_CRITICAL();
+	fixDeadline = deadline;
+	continuous = needContinuous;
+	scheduled = 1;
+	taskEXIT_CRITICAL();
+}
+
+uint8_t GpsDutyIsAsleep(void)
+{
+	return asleep;
+}
+
+static void Sleep(const TickType_t timeNow, const TickType_t duration)
+{
+	CrashTrace(CRASH_TRACE_GPS_SLEEP, duration * portTICK_PERIOD_MS / 1000);
+	UbloxNeoSleep(duration * portTICK_PERIOD_MS);
+
+	wakeTime = timeNow + duration;
+	asleep = 1;
+	fixHeld = 0;
+
+	// Nothing is coming over the UART until it wakes, STOP is fine
+	LowPowerUnlock(LOW_POWER_LOCK_GPS);
+}
+
+static void Wake(const uint8_t early)
+{
+	CrashTrace(CRASH_TRACE_GPS_WAKE, early);
+
+	// Clocks back on before the receiver starts talking
+	LowPowerLock(LOW_POWER_LOCK_GPS);
+
+	// The receiver wakes itself when its period is up
+	if (early)
+	{
+		UbloxNeoWake();
+	}
+
+	asleep = 0;
+}
+
+// Run from the GPS hub loop
+// haveFix is whether the receiver has a current fix
+// Returns 1 when the receiver was just woken, so link timeouts can be restarted
+uint8_t GpsDutyService(const uint8_t haveFix)
+{
+	TickType_t timeNow = xTaskGetTickCount();
+	TickType_t deadline;
+	uint8_t needContinuous;
+
+	taskENTER_CRITICAL();
+	deadline = fixDeadline;
+	needContinuous = continuous || !scheduled;
+	taskEXIT_CRITICAL();
+
+	if (asleep)
+	{
+		// Flight phase changed under us, get it going now
+		if (needContinuous)
+		{
+			Wake(1);
+			return 1;
+		}
+
+		if ((int32_t)(timeNow - wakeTime) >= 0)
+		{
+			Wake(0);
+			return 1;
+		}
+
+		return 0;
+	}
+
+	// Track how long the fix has been held
+	if (!haveFix)
+	{
+		fixHeld = 0;
+		return 0;
+	}
+
+	if (!fixHeld)
+	{
+		fixHeld = 1;
+		fixSince = timeNow;
+	}
+
+	if (needContinuous || timeNow - fixSince < GPS_SETTLE_TIME)
+	{
+		return 0;
+	}
+
+	// Only worth it if there's a decent gap before we have to be back
+	if ((int32_t)(deadline - timeNow) < GPS_WAKE_LEAD + GPS_SLEEP_MIN)
+	{
+		return 0;
+	}
+
+	Sleep(timeNow, deadline - timeNow - GPS_WAKE_LEAD);
+
+	return 0;
+}
@@ -0,0 +1,11 @@
+#ifndef GPSDUTY_H
+#define GPSDUTY_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+void GpsDutySchedule(const TickType_t deadline, const uint8_t needContinuous);
+uint8_t GpsDutyIsAsleep(void);
+uint8_t GpsDutyService(const uint8_t haveFix);
+
+#endif // !GPSDUTY_H
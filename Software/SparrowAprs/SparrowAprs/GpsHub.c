@@ -1,234 +1,700 @@
-#include <stm32f4xx_hal.h>
-#include "FreeRTOS.h"
-#include "task.h"
-#include <math.h>
-#include <stdint.h>
-#include <string.h>
-#include "Nmea0183.h"
-#include "Rtc.h"
-#include "time.h"
-#include "UbloxNeo.h"
-#include "GpsHub.h"
-#include "Helpers.h"
-
-// Max difference between RTC and GPS time allowed in S
-#define MAX_TIME_DELTA			5
-
-// Max GPS packet timeout before we reconfigure in mS
-#define MAX_GPS_TIMEOUT			2500
-#define GPS_RECONFIGURE_TIMEOUT	5000
-
-#define GPS_EPOCH				1900
-
-// Frequency of situation updates
-#define SITUATION_UPDATE		1000
-
-typedef struct
-{
-	float Lat;
-	float Lon;
-	float Altitude;
-	float LastAltitude;
-	float Track;
-	float LastTrack;
-	float Speed;
-	float LastSpeed;
-} InternalSituationInfoT;
-
-static QueueHandle_t* situationQueue;
-
-static void GpsHubTask(void* pvParameters);
-static TaskHandle_t gpsHubTaskHandle = NULL;
-
-void GpsHubInit(void)
-{
-	situationQueue = xQueueCreate(1, sizeof(SituationInfoT));
-
-	if (situationQueue == NULL)
-	{
-		return;
-	}
-}
-
-void GpsHubStartTask(void)
-{
-	// Create task
-	xTaskCreate(GpsHubTask,
-		"GpsHub",
-		300,
-		NULL,
-		5,
-		&gpsHubTaskHandle);
-}
-
-void HandleNewZda(const NmeaZdaT* zda)
-{
-	struct tm time;
-	uint32_t gpsTimeStamp;
-	uint32_t currentTime;
-
-	// Ignore if we have no fix
-	if (!zda->Valid || zda->Year == 0)
-	{
-		return;
-	}
-
-	// Get the current time
-	currentTime = RtcGet();
-	
-	// Load the time structure with GPS fields
-	time.tm_hour = zda->Time.Hour;
-	time.tm_min  = zda->Time.Minute;
-	time.tm_sec  = zda->Time.Second;
-	time.tm_year = (zda->Year - GPS_EPOCH);
-	time.tm_mon  = (zda->Month - 1);
-	time.tm_mday = zda->Day;
-
-	// Make timestamp from GPS time
-	gpsTimeStamp = (uint32_t)mktime(&time);
-
-	// If there is more than 5 second difference between our system time and GPS
-	// Because of uint32_t arithmatic, one of these comparsions will always be true if one value is larger than the other
-	// If both are true, it means one value is larger than the other, and that difference is more than MAX_TIME_DELTA
-	if (currentTime - gpsTimeStamp >= MAX_TIME_DELTA && gpsTimeStamp - currentTime >= MAX_TIME_DELTA)
-	{
-		// Set the new system time
-		RtcSet(gpsTimeStamp);
-		printf("Set RTC\r\n");
-	}
-}
-
-void GpsHubGetSituation(SituationInfoT* situation)
-{
-	xQueuePeek(situationQueue, situation, 0);
-}
-
-static void GpsHubTask(void* pvParameters)
-{
-	GenericNmeaMessageT msg;
-	QueueHandle_t* nmeaQueue;
-	TickType_t lastTaskTime = 0;
-	TickType_t lastSituationUpdateTime = 0;
-
-	TickType_t lastCheckForTimeoutTime = 0;
-	TickType_t lastGga = 0;
-	TickType_t lastZda = 0;
-	TickType_t lastRmc = 0;
-	TickType_t timeNow;
-
-	InternalSituationInfoT situation;
-	SituationInfoT beaconInfo;
-
-	// Get GPS NMEA queue
-	nmeaQueue = Nmea0183GetQueue();
-
-	// Something has gone wrong if we never get this
-	if (nmeaQueue == NULL)
-	{
-		return;
-	}
-
-	// Task loop
-	while (1)
-	{
-		// Block until it's time to start
-		vTaskDelayUntil(&lastTaskTime, 100);
-
-		timeNow = xTaskGetTickCount();
-
-		// Try to get a new message from NMEA as long as there is data to read
-		if(!xQueueIsQueueEmptyFromISR(nmeaQueue))
-		{
-			// Fetch the message
-			if(xQueueReceive(nmeaQueue, &msg, 0))
-			{
-				// Handle messages
-				switch(msg.MessageType)
-				{
-					// Handle GGA message
-					case NMEA_MESSAGE_TYPE_GGA :
-						// Mark that we did get a packet
-						lastGga = timeNow;
-
-						// Ignore if we have no fix or if the fix is not present
-						if (!IsAscii(msg.Gga.Fix) || msg.Gga.Fix <= '0')
-						{
-							continue;
-						}
-
-						situation.Lat = msg.Gga.Position.Lat;
-						situation.Lon = msg.Gga.Position.Lon;
-						situation.Altitude = msg.Gga.Altitude;
-						break;
-
-					// Handle RMC message
-					case NMEA_MESSAGE_TYPE_RMC :
-						// Mark that we did get a packet
-						lastRmc = timeNow;
-
-						// Ignore if we have no fix
-						if (msg.Rmc.Fix != 'A')
-						{
-							continue;
-						}
-
-						// Exact from the new GPS packet
-						situation.LastSpeed = situation.Speed;
-						situation.Speed = msg.Rmc.Speed;
-						situation.LastTrack = situation.Track;
-						situation.Track = msg.Rmc.Track;
-						break;
-					
-					// Handle ZDA message
-					case NMEA_MESSAGE_TYPE_ZDA :
-						// Mark that we did get a packet
-						lastZda = timeNow;
-						HandleNewZda(&msg.Zda);
-						break;
-
-				default:
-				case NMEA_MESSAGE_TYPE_GSA:
-					break;
-				}
-			}
-		}
-
-		// Check for GPS timeouts on packets
-		if (timeNow - lastCheckForTimeoutTime > GPS_RECONFIGURE_TIMEOUT)
-		{
-			lastCheckForTimeoutTime = timeNow;
-
-			if (timeNow - lastGga > MAX_GPS_TIMEOUT)
-			{
-				UbloxNeoSetOutputRate("GGA", 1);
-			}
-
-			if (timeNow - lastRmc > MAX_GPS_TIMEOUT)
-			{
-				UbloxNeoSetOutputRate("RMC", 1);
-			}
-
-			if (timeNow - lastZda > MAX_GPS_TIMEOUT)
-			{
-				UbloxNeoSetOutputRate("ZDA", 2);
-			}
-		}
-
-		// 1hz updates to situation
-		if (timeNow - lastSituationUpdateTime > SITUATION_UPDATE)
-		{
-			// Fill out situation info
-			beaconInfo.Lat = situation.Lat;
-			beaconInfo.Lon = situation.Lon;
-			beaconInfo.Altitude = situation.Altitude;
-			beaconInfo.dAltitude = situation.Altitude - situation.LastAltitude;
-			beaconInfo.Speed = situation.Speed;
-			beaconInfo.dSpeed = situation.Speed - situation.LastSpeed;
-			beaconInfo.Track = situation.Track;
-			beaconInfo.dTrack = situation.Track - situation.LastTrack;
-
-			// Enqueue
-			xQueueOverwrite(situationQueue, &beaconInfo);
-		}
-	}
-}
\ No newline at end of file
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+#include "Nmea0183.h"
+#include "Rtc.h"
+#include "time.h"
+#include "UbloxNeo.h"
+#include "GpsHub.h"
+#include "Helpers.h"
+#include "Region.h"
+#include "GpsAiding.h"
+#include "GpsDuty.h"
+
+// Max difference between RTC and GPS time allowed in S
+#define MAX_TIME_DELTA			5
+
+// How often LSI is measured again while we have GPS time, in mS
+#define LSI_CALIBRATION_PERIOD	600000
+
+// Max GPS packet timeout before we reconfigure in mS
+#define MAX_GPS_TIMEOUT			2500
+#define GPS_RECONFIGURE_TIMEOUT	5000
+
+// A fix older than this doesn't count as current
+#define MAX_FIX_AGE				2000
+
+// NMEA fixes are refused when GSA says they're worse than this
+#define GSA_MODE_2D				2
+#define GSA_MODE_3D				3
+#define MAX_FIX_HDOP			10.0f
+
+// NMEA epochs have no end marker, call one complete once the receiver has gone quiet for this long
+#define EPOCH_SETTLE			100
+
+// Rates are taken over at least this long, differences between 5Hz solutions are mostly noise
+// Beyond the stale limit the reference is too old to say anything about now
+#define RATE_INTERVAL			1000
+#define RATE_STALE				30000
+
+// Receiver time tags, NMEA is ms of the day, NAV-PVT ms of the GPS week
+#define EPOCH_SOURCE_NMEA		0
+#define EPOCH_SOURCE_UBX		1
+#define NMEA_TAG_PERIOD			86400000UL
+#define UBX_TAG_PERIOD			604800000UL
+
+// Everything we act on
+#define GPS_HUB_INTEREST		(NMEA_INTEREST(NMEA_MESSAGE_TYPE_GGA) | NMEA_INTEREST(NMEA_MESSAGE_TYPE_RMC) \
+								| NMEA_INTEREST(NMEA_MESSAGE_TYPE_GSA) | NMEA_INTEREST(NMEA_MESSAGE_TYPE_ZDA) \
+								| NMEA_INTEREST(NMEA_MESSAGE_TYPE_PVT) | NMEA_INTEREST(NMEA_MESSAGE_TYPE_GSV) \
+								| NMEA_INTEREST(NMEA_MESSAGE_TYPE_VTG) | NMEA_INTEREST(NMEA_MESSAGE_TYPE_GLL))
+
+#define GPS_EPOCH				1900
+
+// Housekeeping period when the receiver is quiet
+#define SITUATION_UPDATE		1000
+
+// How often a link recovery is stepped, each rate it tries is listened to for over a second
+#define RECOVERY_STEP			100
+
+// NAV-PVT fix types
+#define UBX_FIX_TYPE_2D			2
+#define UBX_FIX_TYPE_3D			3
+
+#define MM_PER_S_TO_KNOTS		0.00194384f
+
+// Everything the receiver said about one instant
+// Sentences are collected by their time tag, the untimed ones (GSA, VTG) join whichever epoch is open
+typedef struct
+{
+	uint8_t Open;
+	uint8_t Source;
+	uint32_t Tag;
+	TickType_t Tick;
+	TickType_t LastMessage;
+	uint8_t HavePosition;
+	uint8_t HaveAltitude;
+	uint8_t HaveVelocity;
+	uint8_t Vetoed;
+	int32_t Lat;
+	int32_t Lon;
+	float Altitude;
+	float Speed;
+	float Track;
+} GpsEpochT;
+
+// Published situation, kept as a latch: two copies and a sequence count
+// The writer bumps the count before rewriting each copy, so the copy the count points at is never the one being written
+// Readers that outrank the hub never retry, ones it preempts retry at most once per fix
+static volatile uint32_t storeSequence = 0;
+static SituationInfoT store[2];
+
+// Tasks woken on every new fix
+#define MAX_SUBSCRIBERS			4
+static TaskHandle_t subscribers[MAX_SUBSCRIBERS];
+static volatile uint32_t subscriberCount = 0;
+
+// Epoch being assembled
+static GpsEpochT epoch;
+
+// Last published fix, and the one rates are measured against
+static SituationInfoT situation;
+static GpsEpochT rateReference;
+static uint8_t haveRateReference = 0;
+
+// When LSI was last measured, RtcInit did it at boot
+static TickType_t lastCalibration = 0;
+
+static void GpsHubTask(void* pvParameters);
+static TaskHandle_t gpsHubTaskHandle = NULL;
+
+void GpsHubInit(void)
+{
+	memset(store, 0, sizeof(store));
+}
+
+void GpsHubStartTask(void)
+{
+	// Create task
+	xTaskCreate(GpsHubTask,
+		"GpsHub",
+		300,
+		NULL,
+		5,
+		&gpsHubTaskHandle);
+}
+
+static void HandleNewTime(const uint32_t year, const uint8_t month, const uint8_t day, const uint8_t hour, const uint8_t minute, const uint8_t second)
+{
+	struct tm time;
+	uint32_t gpsTimeStamp;
+	uint32_t currentTime;
+	TickType_t tick = xTaskGetTickCount();
+
+	// LSI keeps the RTC and the sleep timing, and it moves with temperature, so measure it again now and then
+	if (tick - lastCalibration >= LSI_CALIBRATION_PERIOD / portTICK_PERIOD_MS)
+	{
+		lastCalibration = tick;
+		RtcCalibrate();
+	}
+
+	// Get the current time
+	currentTime = RtcGet();
+	
+	// Load the time structure with GPS fields
+	time.tm_hour = hour;
+	time.tm_min  = minute;
+	time.tm_sec  = second;
+	time.tm_year = (year - GPS_EPOCH);
+	time.tm_mon  = (month - 1);
+	time.tm_mday = day;
+
+	// Make timestamp from GPS time
+	gpsTimeStamp = (uint32_t)mktime(&time);
+
+	// If there is more than 5 second difference between our system time and GPS
+	// Because of uint32_t arithmatic, one of these comparsions will always be true if one value is larger than the other
+	// If both are true, it means one value is larger than the other, and that difference is more than MAX_TIME_DELTA
+	if (currentTime - gpsTimeStamp >= MAX_TIME_DELTA && gpsTimeStamp - currentTime >= MAX_TIME_DELTA)
+	{
+		// Set the new system time
+		RtcSet(gpsTimeStamp);
+		printf("Set RTC\r\n");
+	}
+}
+
+static void HandleNewZda(const NmeaZdaT* zda)
+{
+	// Ignore if we have no fix
+	if (!zda->Valid || zda->Year == 0)
+	{
+		return;
+	}
+
+	HandleNewTime(zda->Year, zda->Month, zda->Day, zda->Time.Hour, zda->Time.Minute, (uint8_t)zda->Time.Second);
+}
+
+static uint32_t NmeaTimeTag(const NmeaTimeT* time)
+{
+	return (time->Hour * 3600UL + time->Minute * 60UL) * 1000UL + (uint32_t)(time->Second * 1000.0f + 0.5f);
+}
+
+// Real time between two epochs in ms
+// The receiver's own time tags are exact, arrival ticks are only used when the sources differ
+static uint32_t EpochElapsed(const GpsEpochT* from, const GpsEpochT* to)
+{
+	uint32_t period;
+
+	if (from->Source != to->Source)
+	{
+		return (to->Tick - from->Tick) * portTICK_PERIOD_MS;
+	}
+
+	period = (to->Source == EPOCH_SOURCE_UBX) ? UBX_TAG_PERIOD : NMEA_TAG_PERIOD;
+
+	return (to->Tag + period - from->Tag) % period;
+}
+
+static void StoreWrite(const SituationInfoT* s)
+{
+	uint32_t i;
+
+	// Odd, readers take copy 1 while copy 0 is rewritten
+	storeSequence++;
+	__DMB();
+	store[0] = *s;
+	__DMB();
+
+	// Even, and the other way round
+	storeSequence++;
+	__DMB();
+	store[1] = *s;
+	__DMB();
+
+	for (i = 0; i < subscriberCount; i++)
+	{
+		xTaskNotify(subscribers[i], GPS_HUB_NOTIFY_FIX, eSetBits);
+	}
+}
+
+// Publish a finished epoch as the new situation
+static void EpochPublish(const GpsEpochT* e)
+{
+	uint32_t elapsed;
+	float dTrack;
+
+	situation.Sequence++;
+	situation.Timestamp = e->Tick;
+	situation.FixValid = 1;
+	situation.AltitudeValid = e->HaveAltitude;
+	situation.VelocityValid = e->HaveVelocity;
+	situation.Lat = e->Lat;
+	situation.Lon = e->Lon;
+	situation.Altitude = e->HaveAltitude ? e->Altitude : 0;
+	situation.Speed = e->HaveVelocity ? e->Speed : 0;
+	situation.Track = e->HaveVelocity ? e->Track : 0;
+
+	// Rates per second, against a reference at least RATE_INTERVAL back
+	// In between, the last rates stand
+	elapsed = haveRateReference ? EpochElapsed(&rateReference, e) : 0;
+
+	if (!haveRateReference || elapsed > RATE_STALE)
+	{
+		situation.dAltitude = 0;
+		situation.dSpeed = 0;
+		situation.dTrack = 0;
+		rateReference = *e;
+		haveRateReference = 1;
+	}
+	else if (elapsed >= RATE_INTERVAL)
+	{
+		situation.dAltitude = (e->HaveAltitude && rateReference.HaveAltitude)
+			? (e->Altitude - rateReference.Altitude) * 1000.0f / elapsed : 0;
+
+		if (e->HaveVelocity && rateReference.HaveVelocity)
+		{
+			// Shortest way round
+			dTrack = e->Track - rateReference.Track;
+
+			if (dTrack > 180.0f)
+			{
+				dTrack -= 360.0f;
+			}
+			else if (dTrack < -180.0f)
+			{
+				dTrack += 360.0f;
+			}
+
+			situation.dSpeed = (e->Speed - rateReference.Speed) * 1000.0f / elapsed;
+			situation.dTrack = dTrack * 1000.0f / elapsed;
+		}
+		else
+		{
+			situation.dSpeed = 0;
+			situation.dTrack = 0;
+		}
+
+		rateReference = *e;
+	}
+
+	StoreWrite(&situation);
+
+	// Warm start material for the next boot
+	GpsAidingStoreFix(e->Lat, e->Lon, e->HaveAltitude ? (int32_t)(e->Altitude * 1000.0f) : 0);
+
+	// Keep track of which APRS frequency is local
+	RegionUpdate(e->Lat, e->Lon);
+}
+
+// Finish the open epoch, only a fix nothing has objected to is worth publishing
+// An epoch without one leaves the last fix standing, its timestamp tells how old it is
+static void EpochClose(void)
+{
+	if (epoch.Open && epoch.HavePosition && !epoch.Vetoed)
+	{
+		EpochPublish(&epoch);
+	}
+
+	epoch.Open = 0;
+}
+
+// A timed message, starts a new epoch unless it belongs to the open one
+static void EpochEnter(const uint8_t source, const uint32_t tag, const TickType_t tick)
+{
+	if (epoch.Open && (epoch.Source != source || epoch.Tag != tag))
+	{
+		EpochClose();
+	}
+
+	if (!epoch.Open)
+	{
+		memset(&epoch, 0, sizeof(GpsEpochT));
+		epoch.Open = 1;
+		epoch.Source = source;
+		epoch.Tag = tag;
+		epoch.Tick = tick;
+	}
+
+	epoch.LastMessage = tick;
+}
+
+// An untimed message, only meaningful alongside the epoch it came with
+static uint8_t EpochJoin(const TickType_t tick)
+{
+	if (!epoch.Open)
+	{
+		return 0;
+	}
+
+	epoch.LastMessage = tick;
+
+	return 1;
+}
+
+// A message that should carry a time but may have left it empty
+// Without one it can only join the open epoch, it mustn't split it
+static uint8_t EpochEnterOrJoin(const uint8_t timeValid, const NmeaTimeT* time, const TickType_t tick)
+{
+	if (!timeValid)
+	{
+		return EpochJoin(tick);
+	}
+
+	EpochEnter(EPOCH_SOURCE_NMEA, NmeaTimeTag(time), tick);
+
+	return 1;
+}
+
+// A NAV-PVT carries the whole epoch, time, position and velocity
+static void HandleNewPvt(const UbxNavPvtT* pvt, const TickType_t tick)
+{
+	if (pvt->TimeValid)
+	{
+		HandleNewTime(pvt->Year, pvt->Month, pvt->Day, pvt->Hour, pvt->Minute, pvt->Second);
+	}
+
+	EpochEnter(EPOCH_SOURCE_UBX, pvt->ITow, tick);
+
+	// No fix, nothing to publish
+	if (pvt->FixOk && (pvt->FixType == UBX_FIX_TYPE_2D || pvt->FixType == UBX_FIX_TYPE_3D))
+	{
+		epoch.HavePosition = 1;
+		epoch.Lat = pvt->Lat;
+		epoch.Lon = pvt->Lon;
+		epoch.HaveAltitude = (pvt->FixType == UBX_FIX_TYPE_3D);
+		epoch.Altitude = pvt->AltitudeMsl / 1000.0f;
+		epoch.HaveVelocity = 1;
+		epoch.Speed = pvt->GroundSpeed * MM_PER_S_TO_KNOTS;
+		epoch.Track = pvt->Heading / 1e5f;
+	}
+
+	// Nothing else is coming for this one
+	EpochClose();
+}
+
+// A new NMEA position, from GGA or GLL
+static void HandleNewNmeaPosition(const NmeaPositionT* position)
+{
+	epoch.HavePosition = 1;
+	epoch.Lat = position->Lat;
+	epoch.Lon = position->Lon;
+}
+
+// New course and speed, from RMC or VTG
+static void HandleNewNmeaVelocity(const float speed, const float track)
+{
+	epoch.HaveVelocity = 1;
+	epoch.Speed = speed;
+	epoch.Track = track;
+}
+
+// Take a consistent snapshot of the latest situation, never blocks
+// Returns 0 if there is no situation yet
+uint8_t GpsHubGetSituation(SituationInfoT* situation)
+{
+	uint32_t sequence;
+
+	do
+	{
+		sequence = storeSequence;
+		__DMB();
+		*situation = store[sequence & 1];
+		__DMB();
+	} while (sequence != storeSequence);
+
+	return situation->Sequence != 0;
+}
+
+// Have task woken with GPS_HUB_NOTIFY_FIX on every new fix
+// The task must not use its notification value for anything else
+// Returns 0 if there's no room left
+uint8_t GpsHubSubscribe(const TaskHandle_t task)
+{
+	uint8_t result = 0;
+
+	taskENTER_CRITICAL();
+
+	if (subscriberCount < MAX_SUBSCRIBERS)
+	{
+		subscribers[subscriberCount] = task;
+		subscriberCount++;
+		result = 1;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return result;
+}
+
+// Block a subscribed task until there's a situation newer than lastSequence
+// Returns 0 on timeout, situation then holds the latest anyway
+uint8_t GpsHubWaitSituation(SituationInfoT* situation, const uint32_t lastSequence, TickType_t timeout)
+{
+	TimeOut_t timeOut;
+
+	vTaskSetTimeOutState(&timeOut);
+
+	while (1)
+	{
+		// A notification left over from a fix already seen just costs a pass round
+		if (GpsHubGetSituation(situation) && situation->Sequence != lastSequence)
+		{
+			return 1;
+		}
+
+		if (xTaskCheckForTimeOut(&timeOut, &timeout) == pdTRUE
+			|| xTaskNotifyWait(0, GPS_HUB_NOTIFY_FIX, NULL, timeout) == pdFALSE)
+		{
+			return 0;
+		}
+	}
+}
+
+static void GpsHubTask(void* pvParameters)
+{
+	GenericNmeaMessageT msg;
+	QueueHandle_t* nmeaQueue;
+	TickType_t wait;
+
+	TickType_t lastCheckForTimeoutTime = 0;
+	TickType_t lastPvt = 0;
+	TickType_t lastGsv = 0;
+	NmeaGsvT gsv;
+	uint32_t lastFrameCount = 0;
+	TickType_t timeNow;
+	uint8_t haveFix;
+
+	int32_t lastLat;
+	int32_t lastLon;
+	int32_t lastAltitude;
+
+	// Get GPS NMEA queue
+	nmeaQueue = Nmea0183GetQueue();
+
+	// Something has gone wrong if we never get this
+	if (nmeaQueue == NULL)
+	{
+		return;
+	}
+
+	// Start from where we were before the reset, good enough to pick the local frequency
+	// It is not a fix though, so nothing gets beaconed until the receiver confirms one
+	if (GpsAidingGetLastFix(&lastLat, &lastLon, &lastAltitude))
+	{
+		RegionUpdate(lastLat, lastLon);
+	}
+
+	// Only have NMEA queue what we use
+	Nmea0183SetInterest(GPS_HUB_INTEREST);
+
+	// Ask for binary NAV-PVT, the NMEA handlers stay as a fallback for a receiver that ignores us
+	UbloxNeoConfigure();
+
+	// Hand the receiver everything we saved for a warm start
+	GpsAidingRestore();
+
+	// Task loop
+	while (1)
+	{
+		// Block until NMEA has a message for us, or it's time for housekeeping
+		// An open epoch only waits long enough to see whether anything else belongs to it
+		wait = epoch.Open ? EPOCH_SETTLE : (UbloxNeoIsRecovering() ? RECOVERY_STEP : SITUATION_UPDATE);
+
+		// Drain everything that's waiting, a backed up queue must not turn into lag
+		while (xQueueReceive(nmeaQueue, &msg, wait))
+		{
+			wait = 0;
+			timeNow = xTaskGetTickCount();
+
+			// Handle messages
+			switch(msg.MessageType)
+			{
+				// Handle GGA message
+				case NMEA_MESSAGE_TYPE_GGA :
+					if (!EpochEnterOrJoin(msg.Gga.TimeValid, &msg.Gga.Time, timeNow))
+					{
+						break;
+					}
+
+					// Ignore if we have no fix or if the fix is not present
+					if (!IsAscii(msg.Gga.Fix) || msg.Gga.Fix <= '0' || !msg.Gga.PositionValid)
+					{
+						break;
+					}
+
+					HandleNewNmeaPosition(&msg.Gga.Position);
+
+					if (msg.Gga.AltitudeValid)
+					{
+						epoch.HaveAltitude = 1;
+						epoch.Altitude = msg.Gga.Altitude;
+					}
+
+					// No GSA to tell us otherwise, HDOP is the best check we have
+					if (msg.Gga.HDopValid && msg.Gga.HDop > MAX_FIX_HDOP)
+					{
+						epoch.Vetoed = 1;
+					}
+					break;
+
+				// Handle GLL message, position only
+				case NMEA_MESSAGE_TYPE_GLL :
+					if (!EpochEnterOrJoin(msg.Gll.TimeValid, &msg.Gll.Time, timeNow))
+					{
+						break;
+					}
+
+					if (msg.Gll.Status != 'A')
+					{
+						break;
+					}
+
+					HandleNewNmeaPosition(&msg.Gll.Position);
+					break;
+
+				// Handle RMC message
+				case NMEA_MESSAGE_TYPE_RMC :
+					if (!EpochEnterOrJoin(msg.Rmc.TimeValid, &msg.Rmc.Time, timeNow))
+					{
+						break;
+					}
+
+					// Ignore if we have no fix
+					if (msg.Rmc.Fix != 'A' || !msg.Rmc.PositionValid)
+					{
+						break;
+					}
+
+					// Exact from the new GPS packet, velocity only when it had a track
+					HandleNewNmeaPosition(&msg.Rmc.Position);
+
+					if (msg.Rmc.VelocityValid)
+					{
+						HandleNewNmeaVelocity(msg.Rmc.Speed, msg.Rmc.Track);
+					}
+					break;
+
+				// Handle VTG message
+				case NMEA_MESSAGE_TYPE_VTG :
+					if (!EpochJoin(timeNow) || msg.Vtg.Mode == 'N' || !msg.Vtg.TrackValid)
+					{
+						break;
+					}
+
+					HandleNewNmeaVelocity(msg.Vtg.Speed, msg.Vtg.Track);
+					break;
+
+				// Handle GSA message, fix mode and DOP
+				// It has the final word on whether the epoch's fix is usable
+				case NMEA_MESSAGE_TYPE_GSA :
+					if (!EpochJoin(timeNow))
+					{
+						break;
+					}
+
+					if (msg.Gsa.Mode < GSA_MODE_2D || msg.Gsa.HDop > MAX_FIX_HDOP)
+					{
+						epoch.Vetoed = 1;
+					}
+
+					// A 2D fix has no altitude worth the name
+					if (msg.Gsa.Mode != GSA_MODE_3D)
+					{
+						epoch.HaveAltitude = 0;
+					}
+					break;
+
+				// Handle GSV summary, only used to report on a receiver that can't get a fix
+				case NMEA_MESSAGE_TYPE_GSV :
+					lastGsv = timeNow;
+					gsv = msg.Gsv;
+					break;
+				
+				// Handle ZDA message
+				case NMEA_MESSAGE_TYPE_ZDA :
+					HandleNewZda(&msg.Zda);
+					break;
+
+				// Handle UBX NAV-PVT
+				case NMEA_MESSAGE_TYPE_PVT :
+					lastPvt = timeNow;
+					HandleNewPvt(&msg.Pvt, timeNow);
+					break;
+
+			default:
+				break;
+			}
+		}
+
+		timeNow = xTaskGetTickCount();
+
+		// The receiver has gone quiet, whatever we have for this epoch is all there is
+		if (epoch.Open && timeNow - epoch.LastMessage >= EPOCH_SETTLE)
+		{
+			EpochClose();
+		}
+
+		haveFix = situation.FixValid && timeNow - situation.Timestamp < MAX_FIX_AGE;
+
+		// Sleep the receiver between beacons when we can
+		// Its silence while asleep is expected, so the link timeouts start over when it wakes
+		if (GpsDutyService(haveFix && !GpsAidingIsCapturing()))
+		{
+			lastPvt = timeNow;
+			lastCheckForTimeoutTime = timeNow;
+		}
+
+		// Hunting for the receiver's baud rate, once it's over give it a chance before we go after it again
+		if (UbloxNeoServiceRecovery())
+		{
+			lastPvt = timeNow;
+			lastCheckForTimeoutTime = timeNow;
+			lastFrameCount = Nmea0183GetFrameCount();
+		}
+
+		// Check for GPS timeouts on packets
+		if (!GpsDutyIsAsleep() && !UbloxNeoIsRecovering() && timeNow - lastCheckForTimeoutTime > GPS_RECONFIGURE_TIMEOUT)
+		{
+			lastCheckForTimeoutTime = timeNow;
+
+			// NAV-PVT replaces GGA, RMC and ZDA, so it's the only one worth chasing
+			if (timeNow - lastPvt > MAX_GPS_TIMEOUT)
+			{
+				if (Nmea0183GetFrameCount() == lastFrameCount)
+				{
+					// Nothing valid at all, the receiver has probably reset to another baud rate
+					// Stepped from here on, so situations keep being published while it hunts
+					UbloxNeoStartRecovery();
+				}
+				else
+				{
+					// Talking, just not what we asked for
+					UbloxNeoConfigure();
+				}
+
+				// Give it a chance before we go after it again
+				lastPvt = xTaskGetTickCount();
+			}
+
+			// Say what the sky looks like while we're stuck without a fix
+			if (!haveFix && lastGsv != 0 && timeNow - lastGsv < GPS_RECONFIGURE_TIMEOUT)
+			{
+				printf("GPS: no fix, %c%c %u in view, %u tracked, best %u dBHz\r\n",
+					gsv.Talker[0], gsv.Talker[1], gsv.InView, gsv.Tracked, gsv.MaxCnr);
+			}
+
+			lastFrameCount = Nmea0183GetFrameCount();
+		}
+
+		// Keep the saved aiding data fresh, anything we send would wake the receiver
+		// Nothing goes out at whatever rate we're trying while we hunt for it
+		if (!GpsDutyIsAsleep() && !UbloxNeoIsRecovering())
+		{
+			GpsAidingService(situation.FixValid);
+		}
+	}
+}
@@ -1,26 +1,34 @@
-#ifndef GPSHUB_H
-#define GPSHUB_H
-
-#include "FreeRTOS.h"
-#include "task.h"
-#include <math.h>
-#include <stdint.h>
-#include "queue.h"
-
-typedef struct
-{
-	float Lat;
-	float Lon;
-	float Altitude;
-	float dAltitude;
-	float Track;
-	float dTrack;
-	float Speed;
-	float dSpeed;
-} SituationInfoT;
-
-void GpsHubInit(void);
-void GpsHubStartTask(void);
-void GpsHubGetSituation(SituationInfoT* situation);
-
-#endif // !GPSHUB_H
+#ifndef GPSHUB_H
+#define GPSHUB_H
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include <math.h>
+#include <stdint.h>
+
+#define GPS_HUB_NOTIFY_FIX		(1UL << 0)
+
+typedef struct
+{
+	uint32_t Sequence;
+	TickType_t Timestamp;
+	uint8_t FixValid;
+	uint8_t AltitudeValid;
+	uint8_t VelocityValid;
+	int32_t Lat;
+	int32_t Lon;
+	float Altitude;
+	float dAltitude;
+	float Track;
+	float dTrack;
+	float Speed;
+	float dSpeed;
+} SituationInfoT;
+
+void GpsHubInit(void);
+void GpsHubStartTask(void);
+uint8_t GpsHubGetSituation(SituationInfoT* situation);
+uint8_t GpsHubSubscribe(const TaskHandle_t task);
+uint8_t GpsHubWaitSituation(SituationInfoT* situation, const uint32_t lastSequence, TickType_t timeout);
+
+#endif // !GPSHUB_H
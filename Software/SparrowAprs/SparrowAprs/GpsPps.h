@@ -1,7 +1,7 @@
-#ifndef GPSPPS_H
-#define GPSPPS_H
-
-void GpsPpsInit(void);
-
-
-#endif // !GPSPPS_H
+#ifndef GPSPPS_H
+#define GPSPPS_H
+
+void GpsPpsInit(void);
+
+
+#endif // !GPSPPS_H
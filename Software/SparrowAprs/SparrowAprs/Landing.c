@@ -0,0 +1,280 @@
+/*
+	Landing prediction
+
+	On the way up every fix is a free wind measurement: at float altitudes a
+	balloon goes wherever the air goes. Horizontal velocity is binned by
+	altitude layer as it comes in, one running mean per layer.
+
+	After burst the descent is flown back down through those layers. Under a
+	parachute the sink rate goes with 1/sqrt(density), and with an exponential
+	atmosphere the time spent crossing a layer factors into
+
+		t = exp(h / 2H) / v * integral(exp(-z / 2H) dz over the layer)
+
+	where h and v are where we are now and how fast we're falling. The
+	integral only depends on the layer, so the wind times it is summed up
+	from the ground once at burst and each fix after that is a couple of
+	expf() calls and a lookup, however many layers are left below us.
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <math.h>
+#include <string.h>
+#include "GpsHub.h"
+#include "Altimeter.h"
+#include "Landing.h"
+
+// Wind layers
+#define LAYER_HEIGHT			500.0f
+#define LAYER_COUNT				80
+
+// Twice the density scale height, m
+#define SCALE_HEIGHT_2			14476.0f
+
+// Don't trust a sink rate slower than this, we'd predict a landing in the next county
+#define MIN_DESCENT_SPEED		1.0f
+
+// A fix this old can't be built on
+#define MAX_FIX_AGE				5000
+
+#define KNOTS_TO_MPS			0.514444f
+#define DEGREES_TO_RADIANS		0.0174533f
+
+// 1e-7 degrees of latitude per metre
+#define DEGREES_PER_METER		89.8315f
+
+typedef struct
+{
+	float North;
+	float East;
+	uint16_t Count;
+} WindLayerT;
+
+static WindLayerT layers[LAYER_COUNT];
+
+// Drift per unit of exp(h / 2H) / v for everything below the bottom of each layer
+static float driftNorth[LAYER_COUNT];
+static float driftEast[LAYER_COUNT];
+
+static uint8_t haveGround = 0;
+static float groundAltitude;
+static uint8_t descentPlanned = 0;
+
+// Published to other tasks under a critical section
+static LandingPredictionT prediction;
+
+static void LandingTask(void* pvParameters);
+static TaskHandle_t landingTaskHandle = NULL;
+
+void LandingInit(void)
+{
+	memset(layers, 0, sizeof(layers));
+	memset(&prediction, 0, sizeof(prediction));
+}
+
+void LandingStartTask(void)
+{
+	// Create task
+	xTaskCreate(LandingTask,
+		"Landing",
+		256,
+		NULL,
+		2,
+		&landingTaskHandle);
+
+	// Woken by the hub on new fixes
+	GpsHubSubscribe(landingTaskHandle);
+}
+
+// Returns 0 if there is no prediction
+uint8_t LandingGetPrediction(LandingPredictionT* p)
+{
+	taskENTER_CRITICAL();
+	*p = prediction;
+	taskEXIT_CRITICAL();
+
+	return p->Valid;
+}
+
+static uint32_t LayerIndex(const float altitude)
+{
+	if (altitude <= 0)
+	{
+		return 0;
+	}
+
+	if (altitude >= LAYER_HEIGHT * (LAYER_COUNT - 1))
+	{
+		return LAYER_COUNT - 1;
+	}
+
+	return (uint32_t)(altitude / LAYER_HEIGHT);
+}
+
+// Integral of exp(-z / 2H) from a to b
+static float LayerWeight(const float a, const float b)
+{
+	return SCALE_HEIGHT_2 * (expf(-a / SCALE_HEIGHT_2) - expf(-b / SCALE_HEIGHT_2));
+}
+
+// Fold one fix into the running mean for its layer
+static void AddWind(const float altitude, const float north, const float east)
+{
+	WindLayerT* layer = &layers[LayerIndex(altitude)];
+
+	// Stop counting before it wraps, the mean is settled long before then
+	if (layer->Count < UINT16_MAX)
+	{
+		layer->Count++;
+	}
+
+	layer->North += (north - layer->North) / layer->Count;
+	layer->East += (east - layer->East) / layer->Count;
+}
+
+// Sum up drift from the ground, once the wind profile is final
+// Layers we never saw borrow from the nearest one below that we did
+static void PlanDescent(void)
+{
+	uint32_t ground = LayerIndex(groundAltitude);
+	uint32_t i;
+	float bottom;
+	float weight;
+
+	for (i = 0; i < LAYER_COUNT; i++)
+	{
+		if (i > 0 && layers[i].Count == 0)
+		{
+			layers[i].North = layers[i - 1].North;
+			layers[i].East = layers[i - 1].East;
+		}
+
+		if (i <= ground)
+		{
+			driftNorth[i] = 0;
+			driftEast[i] = 0;
+			continue;
+		}
+
+		bottom = (i - 1) * LAYER_HEIGHT;
+		weight = LayerWeight(i - 1 == ground ? groundAltitude : bottom, bottom + LAYER_HEIGHT);
+		driftNorth[i] = driftNorth[i - 1] + layers[i - 1].North * weight;
+		driftEast[i] = driftEast[i - 1] + layers[i - 1].East * weight;
+	}
+
+	descentPlanned = 1;
+}
+
+// Fly the rest of the descent from here
+static void Predict(const SituationInfoT* situation, const float altitude, const float sinkSpeed)
+{
+	uint32_t layer = LayerIndex(altitude);
+	float bottom = layer * LAYER_HEIGHT;
+	float weight;
+	float scale;
+	float north;
+	float east;
+	float cosLat;
+	int32_t lat;
+	int32_t lon;
+
+	if (altitude <= groundAltitude)
+	{
+		scale = 0;
+		north = 0;
+		east = 0;
+	}
+	else
+	{
+		// The layer we're in, from the ground if it's in here too
+		weight = LayerWeight(bottom < groundAltitude ? groundAltitude : bottom, altitude);
+		scale = expf(altitude / SCALE_HEIGHT_2) / sinkSpeed;
+		north = scale * (driftNorth[layer] + layers[layer].North * weight);
+		east = scale * (driftEast[layer] + layers[layer].East * weight);
+	}
+
+	cosLat = cosf(situation->Lat * 1e-7f * DEGREES_TO_RADIANS);
+	lat = situation->Lat + (int32_t)(north * DEGREES_PER_METER);
+	lon = situation->Lon;
+
+	if (cosLat > 0.01f)
+	{
+		lon += (int32_t)(east * DEGREES_PER_METER / cosLat);
+	}
+
+	taskENTER_CRITICAL();
+	prediction.Valid = 1;
+	prediction.Timestamp = situation->Timestamp;
+	prediction.Lat = lat;
+	prediction.Lon = lon;
+	prediction.TimeToLanding = (uint32_t)(scale * LayerWeight(groundAltitude, altitude));
+	taskEXIT_CRITICAL();
+}
+
+static void LandingTask(void* pvParameters)
+{
+	SituationInfoT situation;
+	AltimeterStateT altimeter;
+	float altitude;
+	float north;
+	float east;
+
+	situation.Sequence = 0;
+
+	while (1)
+	{
+		if (!GpsHubWaitSituation(&situation, situation.Sequence, portMAX_DELAY))
+		{
+			continue;
+		}
+
+		AltimeterGetState(&altimeter);
+
+		if (!situation.FixValid || xTaskGetTickCount() - situation.Timestamp > MAX_FIX_AGE)
+		{
+			continue;
+		}
+
+		// Fused altitude keeps going where GPS altitude gives out
+		if (altimeter.Valid)
+		{
+			altitude = altimeter.Altitude;
+		}
+		else if (situation.AltitudeValid)
+		{
+			altitude = situation.Altitude;
+		}
+		else
+		{
+			continue;
+		}
+
+		// The lowest we've been before burst is as good a guess at the ground as any
+		if (!altimeter.Burst && (!haveGround || altitude < groundAltitude))
+		{
+			groundAltitude = altitude;
+			haveGround = 1;
+		}
+
+		if (!altimeter.Burst)
+		{
+			if (situation.VelocityValid)
+			{
+				north = situation.Speed * KNOTS_TO_MPS * cosf(situation.Track * DEGREES_TO_RADIANS);
+				east = situation.Speed * KNOTS_TO_MPS * sinf(situation.Track * DEGREES_TO_RADIANS);
+				AddWind(altitude, north, east);
+			}
+
+			continue;
+		}
+
+		if (!descentPlanned)
+		{
+			PlanDescent();
+		}
+
+		Predict(&situation, altitude, altimeter.VerticalSpeed < -MIN_DESCENT_SPEED ? -altimeter.VerticalSpeed : MIN_DESCENT_SPEED);
+	}
+}
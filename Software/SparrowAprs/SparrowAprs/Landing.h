@@ -0,0 +1,20 @@
+#ifndef LANDING_H
+#define LANDING_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+typedef struct
+{
+	uint8_t Valid;
+	TickType_t Timestamp;
+	int32_t Lat;
+	int32_t Lon;
+	uint32_t TimeToLanding;
+} LandingPredictionT;
+
+void LandingInit(void);
+void LandingStartTask(void);
+uint8_t LandingGetPrediction(LandingPredictionT* prediction);
+
+#endif // !LANDING_H
@@ -0,0 +1,115 @@
+/*
+	Tickless idle
+
+	When the scheduler has nothing to do for a while, stop the tick and
+	drop into STOP mode with the RTC wakeup timer armed for the next task
+	deadline. Any EXTI interrupt can wake us early, the time actually spent
+	asleep is measured against the RTC and stepped into the tick count, and
+	into the HAL's millisecond count which stops with SysTick too. The RTC
+	runs from LSI, which Rtc.c measures against HSE at boot and again
+	whenever the GPS gives us the time.
+
+	With the tick stopped nothing on this path may wait on a HAL timeout,
+	they'd never expire. The clock and RTC code here polls registers a
+	bounded number of times instead.
+
+	STOP halts HSE, the PLL and every peripheral clock, so anything that
+	needs them (DAC audio, GPS UART, USB) holds a lock to keep us in plain
+	sleep instead.
+*/
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Clock.h"
+#include "Rtc.h"
+#include "LowPower.h"
+
+static volatile uint32_t locks = 0;
+
+// Prevent STOP mode. Safe to call from ISRs
+void LowPowerLock(const uint32_t lock)
+{
+	__atomic_fetch_or(&locks, lock, __ATOMIC_RELEASE);
+}
+
+// Allow STOP mode again. Safe to call from ISRs
+void LowPowerUnlock(const uint32_t lock)
+{
+	__atomic_fetch_and(&locks, ~lock, __ATOMIC_RELEASE);
+}
+
+// Called by the idle task with the scheduler suspended
+void LowPowerSuppressTicksAndSleep(TickType_t expectedIdleTime)
+{
+	uint32_t sleepStart;
+	uint32_t sleptMs;
+	uint32_t armedMs;
+
+	// Mask interrupts, though they will still bring us out of WFI
+	__disable_irq();
+
+	// Something became ready while we were getting here
+	if (eTaskConfirmSleepModeStatus() == eAbortSleep)
+	{
+		__enable_irq();
+		return;
+	}
+
+	// Someone needs the clocks, just sleep until the next tick
+	if (locks)
+	{
+		__WFI();
+		__enable_irq();
+		return;
+	}
+
+	// Stop the tick
+	SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+
+	// Arm the wakeup for when the next task needs to run
+	armedMs = RtcStartWakeup(expectedIdleTime * portTICK_PERIOD_MS);
+
+	// Nothing to wake us, carry on with the tick
+	if (armedMs == 0)
+	{
+		SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+		__enable_irq();
+		return;
+	}
+
+	sleepStart = RtcGetDayMillis();
+
+	// Stop
+	HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+	// We're running from HSI now, get the PLL back before anything else runs
+	ClockRestoreAfterStop();
+
+	// Find out how long we were actually out
+	RtcStopWakeup();
+	sleptMs = RtcGetDayMillis() - sleepStart;
+
+	// Midnight rolled over while we were out
+	if ((int32_t)sleptMs < 0)
+	{
+		sleptMs += 86400000UL;
+	}
+
+	// Never step past what the kernel asked for
+	if (sleptMs > armedMs)
+	{
+		sleptMs = armedMs;
+	}
+
+	vTaskStepTick(sleptMs / portTICK_PERIOD_MS);
+
+	// HAL_GetTick() timeouts and intervals have to see the time pass too
+	uwTick += sleptMs;
+
+	// Restart the tick. Reconfiguring the clock reprogrammed it, but make sure it runs
+	SysTick->VAL = 0;
+	SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+
+	// Let the interrupt that woke us run
+	__enable_irq();
+}
\ No newline at end of file
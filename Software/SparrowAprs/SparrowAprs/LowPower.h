@@ -0,0 +1,16 @@
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+// Anything that needs clocks to keep running holds one of these
+#define LOW_POWER_LOCK_RADIO	(1 << 0)
+#define LOW_POWER_LOCK_GPS		(1 << 1)
+#define LOW_POWER_LOCK_USB		(1 << 2)
+
+void LowPowerLock(const uint32_t lock);
+void LowPowerUnlock(const uint32_t lock);
+void LowPowerSuppressTicksAndSleep(TickType_t expectedIdleTime);
+
+#endif // !LOWPOWER_H
@@ -1,704 +1,1205 @@
-/*
-	Simple NMEA183 parser
-		-- Chris Seto, 2018
-
-	Resources
-		* http://www.gpsinformation.org/dale/nmea.htm
-*/
-
-#include <stm32f4xx_hal.h>
-#include <string.h>
-#include "Queuex.h"
-#include "Helpers.h"
-#include "TokenIterate.h"
-#include "Nmea0183.h"
-
-// Sentence processors
-static void ParseGsa(const uint32_t length);
-static void ParseGga(const uint32_t length);
-static void ParseRmc(const uint32_t length);
-static void ParseZda(const uint32_t length);
-static void ProcessSentence(const uint32_t length);
-
-// Packet extractors
-static uint8_t ExtractTime(TokenIterateT* t, NmeaTimeT* time);
-static uint8_t ExtractDate(TokenIterateT* t, NmeaDateT* date);
-static uint8_t ExtractPosition(TokenIterateT* t, NmeaPositionT* pos);
-static uint8_t ExtractChar(TokenIterateT* t, uint8_t* c);
-static uint8_t ExtractFloat(TokenIterateT* t, float* x);
-static uint8_t ExtractInt(TokenIterateT* t, int32_t* x);
-
-typedef struct
-{
-	enum NMEA_MESSAGE_TYPE Type;
-	char Header[5];
-	void(*Processor)(const uint32_t);
-	TickType_t LastMsgTime;
-} NmeaProcessorT;
-
-// Task
-static void Nmea0183Task(void * pvParameters);
-static TaskHandle_t idleTaskHandle = NULL;
-
-// Serial DMA buffer
-#define DMA_BUFFER_SIZE			1000
-static uint8_t dmaBuffer[DMA_BUFFER_SIZE];
-static volatile uint32_t dmaHead = 0;
-
-// Nmea data queue
-#define NMEA_BUFFER_SIZE		1000
-static uint8_t nmeaBuffer[NMEA_BUFFER_SIZE];
-static struct QueueT nmeaQueue;
-
-// Message output queue
-static QueueHandle_t NmeaMessageQueue;
-
-#define NMEA_PACKET_BUFFER_SIZE	100
-static uint8_t packetBuffer[NMEA_PACKET_BUFFER_SIZE];
-
-#define PARSE_STATE_HEADER		0
-#define PARSE_STATE_PAYLOAD		1
-#define PARSE_STATE_CHECKSUM0	2
-#define PARSE_STATE_CHECKSUM1	3
-static uint32_t parserState = PARSE_STATE_HEADER;
-
-// NMEA processors
-#define NMEA_PROCESSOR_COUNT	4
-static NmeaProcessorT processors[NMEA_PROCESSOR_COUNT] = {
-	{ NMEA_MESSAGE_TYPE_GSA, "GNGSA", ParseGsa, 0 },
-	{ NMEA_MESSAGE_TYPE_GGA, "GNGGA", ParseGga, 0 },
-	{ NMEA_MESSAGE_TYPE_RMC, "GNRMC", ParseRmc, 0 },
-	{ NMEA_MESSAGE_TYPE_ZDA, "GNZDA", ParseZda, 0 }
-};
-
-// Peripheral handles
-static UART_HandleTypeDef UartHandle;
-static DMA_HandleTypeDef hdma_rx;
-
-static void InitUart(void)
-{
-	// Init Uart
-	GPIO_InitTypeDef GPIO_InitStruct;
-
-	// Enable clocks
-	__GPIOB_CLK_ENABLE();
-	__USART3_CLK_ENABLE();
-	__DMA1_CLK_ENABLE();
-	
-	// Configure GPIO
-	GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
-	GPIO_InitStruct.Pull      = GPIO_NOPULL;
-	GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_HIGH;
-	GPIO_InitStruct.Pin       = GPIO_PIN_10 | GPIO_PIN_11;
-	GPIO_InitStruct.Alternate = GPIO_AF7_USART3;
-	HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
-	
-	// Configure the USART peripheral
-	UartHandle.Instance          = USART3;
-	UartHandle.Init.BaudRate     = 9600;
-	UartHandle.Init.WordLength   = UART_WORDLENGTH_8B;
-	UartHandle.Init.StopBits     = UART_STOPBITS_1;
-	UartHandle.Init.Parity       = UART_PARITY_NONE;
-	UartHandle.Init.HwFlowCtl    = UART_HWCONTROL_NONE;
-	UartHandle.Init.Mode         = UART_MODE_RX | UART_MODE_TX;
-
-	// Commit the USART
-	HAL_UART_Init(&UartHandle);
-
-	// DMA USART3
-	// RX: (DMA1, Stream 1, channel 4)
-	// TX: (DMA1, Stream 3, Channel 4), (DMA1, Stream 4, Channel 7)
-	hdma_rx.Instance                 = DMA1_Stream1;
-	hdma_rx.Init.Channel             = DMA_CHANNEL_4;
-	hdma_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
-	hdma_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
-	hdma_rx.Init.MemInc              = DMA_MINC_ENABLE;
-	hdma_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
-	hdma_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
-	hdma_rx.Init.Mode                = DMA_CIRCULAR;
-	hdma_rx.Init.Priority            = DMA_PRIORITY_HIGH;
-	hdma_rx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
-	hdma_rx.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
-	hdma_rx.Init.MemBurst            = DMA_MBURST_SINGLE;
-	hdma_rx.Init.PeriphBurst         = DMA_PBURST_SINGLE;
-
-	// Init DMA
-	HAL_DMA_Init(&hdma_rx);
-
-	// Link DMA
-	__HAL_LINKDMA(&UartHandle, hdmarx, hdma_rx);
-
-	// Start DMA
-	HAL_UART_Receive_DMA(&UartHandle, (uint8_t*)&dmaBuffer, DMA_BUFFER_SIZE);
-}
-
-UART_HandleTypeDef* Nmea0183GetUartHandle(void)
-{
-	return &UartHandle;
-}
-
-uint8_t Nmea0183Init(void)
-{
-	// Init RTOS queue
-	NmeaMessageQueue = xQueueCreate(10, sizeof(GenericNmeaMessageT));
-
-	if (NmeaMessageQueue == NULL)
-	{
-		return 0;
-	}
-
-	QueueInit(&nmeaQueue, nmeaBuffer, NMEA_BUFFER_SIZE);
-
-	// Start serial port
-	InitUart();
-
-	return 1;
-}
-
-void Nmea0183StartParser(void)
-{
-	// Start Task
-	xTaskCreate(Nmea0183Task,
-		"Nmea0183ParserTask",
-		256,
-		NULL,
-		6,
-		&idleTaskHandle);
-}
-
-// Verify a packet checksum
-static uint8_t VerifyChecksum(const uint8_t x, const uint8_t* buffer, const uint32_t length)
-{
-	uint8_t checksum = 0;
-	uint32_t i = 0;
-
-	for (i = 0; i < length; i++)
-	{
-		checksum ^= buffer[i];
-	}
-
-	return (x == checksum);
-}
-
-static void CopyFromDma(void)
-{
-	uint32_t endIndex;
-
-	// Get the index of the end of the buffer
-	endIndex =  DMA_BUFFER_SIZE - DMA1_Stream1->NDTR;
-
-	// If there is nothing to copy
-	// If you let the buffer loop back, you will lose the entire buffer
-	if (endIndex == dmaHead)
-	{
-		return;
-	}
-
-	// Check if the buffer looped over
-	if (endIndex < dmaHead)
-	{
-		// Copy from the end of the dma buffer
-		QueueAppendBuffer(&nmeaQueue, dmaBuffer + dmaHead, DMA_BUFFER_SIZE - dmaHead);
-
-		// It has. We need to copy from the end of the circ buffer, then again from the start
-		// Copy from the start of the dma buffer
-		QueueAppendBuffer(&nmeaQueue, dmaBuffer, endIndex);
-	}
-	else
-	{
-		// Copy from the dmaHead to the endindex
-		QueueAppendBuffer(&nmeaQueue, dmaBuffer + dmaHead, endIndex - dmaHead);
-	}
-
-	// Relocate the DMA head to the end of where we just read
-	dmaHead = endIndex;
-}
-
-// Parse NMEA
-static void Nmea0183Task(void * pvParameters)
-{
-	uint32_t parsePtr = 0;
-	uint8_t frameChecksum;
-	uint32_t bufferPtr;
-	uint8_t workingByte;
-	TickType_t xLastNmeaTime = 0;
-
-	// Parse NMEA
-	while (1)
-	{
-		// Block until it's time to start
-		vTaskDelayUntil(&xLastNmeaTime, 10);
-
-		// Import data into the queue from the DMA buffer
-		CopyFromDma();
-
-		// While there is data in the queue
-		while (parsePtr < QueueCount(&nmeaQueue))
-		{
-			// Get the current ptr
-			workingByte = QueuePeek(&nmeaQueue, parsePtr++);
-
-			// State machine parser
-			switch(parserState)
-			{
-				// Look for and consume header byte $
-				case PARSE_STATE_HEADER:
-					if (workingByte == '$')
-					{
-						parserState = PARSE_STATE_PAYLOAD;
-					}
-
-					// Dequeue whatever we get at this point, header or not
-					QueueDequeqe(&nmeaQueue, 1);
-					parsePtr = 0;
-					bufferPtr = 0;
-					break;
-
-				// Wait until we get past the payload
-				case PARSE_STATE_PAYLOAD:
-					if (workingByte == '*')
-					{
-						parserState = PARSE_STATE_CHECKSUM0;
-					}
-					else
-					{
-						packetBuffer[bufferPtr++] = workingByte;
-					}
-					break;
-
-				// First checksum byte
-				case PARSE_STATE_CHECKSUM0:
-
-					// Just collect this byte to start building the checksum
-					frameChecksum = (Hex2int(workingByte) << 4);
-
-					// Move on
-					parserState = PARSE_STATE_CHECKSUM1;
-					break;
-
-				// Second checksum byte
-				case PARSE_STATE_CHECKSUM1 :
-					// Continue building the checksum
-					frameChecksum |= Hex2int(workingByte);
-
-					// Attempt to verify the checksum
-					if (VerifyChecksum(frameChecksum, packetBuffer, bufferPtr))
-					{
-						// Dequeue the entire packet if success
-						QueueDequeqe(&nmeaQueue, parsePtr);
-						parsePtr = 0;
-
-						// Process sentence
-						ProcessSentence(bufferPtr);
-					}
-
-					// Reset
-					parserState = PARSE_STATE_HEADER;
-					break;
-			}
-		}
-	}
-}
-
-static uint8_t MatchUpTo(const uint8_t* x, const uint8_t* y, const uint32_t len)
-{
-	uint32_t i;
-
-	for (i = 0; i < len; i++)
-	{
-		if (x[i] != y[i])
-		{
-			return 0;
-		}
-	}
-
-	return 1;
-}
-
-static void ProcessSentence(const uint32_t length)
-{
-	uint32_t i;
-
-	// Try to match to a known processor 
-	for (i = 0; i < NMEA_PROCESSOR_COUNT; i++)
-	{
-		// Check if we have a match
-		if (MatchUpTo((uint8_t*)processors[i].Header, packetBuffer, 5))
-		{
-			// Call the processor
-			processors[i].Processor(length);
-
-			// Set the last update time
-			processors[i].LastMsgTime = xTaskGetTickCount();
-
-			return;
-		}
-	}
-}
-
-// Extract time
-static uint8_t ExtractTime(TokenIterateT* t, NmeaTimeT* time)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-
-	// Get the token
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if (tokenLength < 6)
-	{
-		return 0;
-	}
-
-	// Hour
-	time->Hour = atoil(token + 0, 2);
-
-	// Minute
-	time->Minute = atoil(token + 2, 2);
-
-	// Second (might be a float)
-	time->Second = atofl(token + 4, tokenLength - 4);
-
-	return 1;
-}
-
-// Extract date
-static uint8_t ExtractDate(TokenIterateT* t, NmeaDateT* date)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-
-	// Get the token
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if(tokenLength < 6)
-	{
-		return 0;
-	}
-
-	// Day
-	date->Day = atoil(token + 0, 2);
-
-	// Month
-	date->Month = atoil(token + 2, 2);
-
-	// Year
-	date->Year = atofl(token + 4, tokenLength - 4);
-
-	return 1;
-}
-
-// Extract position
-static uint8_t ExtractPosition(TokenIterateT* t, NmeaPositionT* pos)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-	
-	int deg = 0;
-	float min = 0;
-	uint8_t dir = '-';
-
-	// Get the token for lat
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if (tokenLength < 4)
-	{
-		return 0;
-	}
-
-	// Get the degrees
-	deg = atoil(token, 2);
-
-	// Get minutes
-	min = atofl(token + 2, tokenLength - 2);
-
-	// Get direction
-	if (!ExtractChar(t, &dir))
-	{
-		return 0;
-	}
-
-	pos->Lat = (deg + (min / 60.0)) * ((dir == 'N') ? 1 : -1);
-	
-	// Get the token for lon
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if (tokenLength < 4)
-	{
-		return 0;
-	}
-
-	// Get the degrees
-	deg = atoil(token, 3);
-
-	// Get minutes
-	min = atofl(token + 2, tokenLength - 3);
-
-	// Get direction
-	if (!ExtractChar(t, &dir))
-	{
-		return 0;
-	}
-
-	pos->Lon = (deg + (min / 60.0)) * ((dir == 'E') ? 1 : -1);
-	
-	return 1;
-}
-
-
-// Extract char
-static uint8_t ExtractChar(TokenIterateT* t, uint8_t* c)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-
-	// Get the token
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if (tokenLength != 1)
-	{
-		*c = 0;
-		return 0;
-	}
-
-	*c = token[0];
-
-	return 1;
-}
-
-// Extract float
-static uint8_t ExtractFloat(TokenIterateT* t, float* x)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-
-	// Get the token
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if (tokenLength == 0)
-	{
-		*x = 0;
-		return 0;
-	}
-
-	*x = atofl(token, tokenLength);
-
-	return 1;
-}
-
-// Extract int
-static uint8_t ExtractInt(TokenIterateT* t, int32_t* x)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-
-	// Get the token
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if (tokenLength == 0)
-	{
-		*x = 0;
-		return 0;
-	}
-
-	*x = atoil(token, tokenLength);
-
-	return 1;
-}
-
-// Extract byte int
-static uint8_t ExtractByteInt(TokenIterateT* t, int8_t* x)
-{
-	uint8_t* token;
-	uint32_t tokenLength;
-
-	// Get the token
-	TokenIteratorForward(t, &token, &tokenLength);
-
-	// Check length
-	if(tokenLength == 0)
-	{
-		*x = 0;
-		return 0;
-	}
-
-	*x = atoil(token, tokenLength);
-
-	return 1;
-}
-
-//// Sentence Parsers ////
-
-static void ParseGsa(const uint32_t length)
-{
-	/*
-		$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39
-
-		Where:
-			 GSA      Satellite status
-			 A        Auto selection of 2D or 3D fix (M = manual) 
-			 3        3D fix - values include: 1 = no fix
-											   2 = 2D fix
-											   3 = 3D fix
-			 04,05... PRNs of satellites used for fix (space for 12) 
-			 2.5      PDOP (dilution of precision) 
-			 1.3      Horizontal dilution of precision (HDOP) 
-			 2.1      Vertical dilution of precision (VDOP)
-			 *39      the checksum data, always begins with *
-
-	*/
-}
-
-static void ParseRmc(const uint32_t length)
-{
-	/*
-	$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A
-
-	Where:
-		 RMC          Recommended Minimum sentence C
-		 123519       Fix taken at 12:35:19 UTC
-		 A            Status A=active or V=Void.
-		 4807.038,N   Latitude 48 deg 07.038' N
-		 01131.000,E  Longitude 11 deg 31.000' E
-		 022.4        Speed over the ground in knots
-		 084.4        Track angle in degrees True
-		 230394       Date - 23rd of March 1994
-		 003.1,W      Magnetic Variation
-		 *6A          The checksum data, always begins with *
-
-	*/
-
-	GenericNmeaMessageT msg;
-	msg.MessageType = NMEA_MESSAGE_TYPE_RMC;
-	TokenIterateT t;
-	TokenIteratorInit(&t, ',', packetBuffer + 6, length - 6);
-
-	// Time
-	ExtractTime(&t, &msg.Rmc.Time);
-
-	// Fix
-	ExtractChar(&t, &msg.Rmc.Fix);
-
-	// Position
-	ExtractPosition(&t, &msg.Rmc.Position);
-
-	// Speed
-	ExtractFloat(&t, &msg.Rmc.Speed);
-
-	// Track
-	ExtractFloat(&t, &msg.Rmc.Track);
-
-	// Date
-	ExtractDate(&t, &msg.Rmc.Date);
-	
-	// Try to queue it
-	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
-}
-
-static void ParseGga(const uint32_t length)
-{
-	/*
-		$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47
-
-		Where:
-			GGA          Global Positioning System Fix Data
-			123519       Fix taken at 12:35:19 UTC
-			4807.038,N   Latitude 48 deg 07.038' N
-			01131.000,E  Longitude 11 deg 31.000' E
-			1            Fix quality: 0 = invalid
-									1 = GPS fix (SPS)
-									2 = DGPS fix
-									3 = PPS fix
-						4 = Real Time Kinematic
-						5 = Float RTK
-									6 = estimated (dead reckoning) (2.3 feature)
-						7 = Manual input mode
-						8 = Simulation mode
-			08           Number of satellites being tracked
-			0.9          Horizontal dilution of position
-			545.4,M      Altitude, Meters, above mean sea level
-			46.9,M       Height of geoid (mean sea level) above WGS84
-							ellipsoid
-			(empty field) time in seconds since last DGPS update
-			(empty field) DGPS station ID number
-			*47          the checksum data, always begins with *
-	*/
-
-	GenericNmeaMessageT msg;
-	msg.MessageType = NMEA_MESSAGE_TYPE_GGA;
-	TokenIterateT t;
-	TokenIteratorInit(&t, ',', packetBuffer + 6, length - 6);
-
-	// Time
-	ExtractTime(&t, &msg.Gga.Time);
-
-	// Position
-	ExtractPosition(&t, &msg.Gga.Position);
-
-	// Fix
-	ExtractChar(&t, &msg.Gga.Fix);
-
-	// Sats tracked
-	ExtractInt(&t, &msg.Gga.SatCount);
-
-	// HDOP
-	ExtractFloat(&t, &msg.Gga.Altitude);
-
-	// Altitude
-	ExtractFloat(&t, &msg.Gga.Altitude);
-
-	// Altitude units
-	ExtractChar(&t, &msg.Gga.AltitudeUnits);
-
-	// Try to queue it
-	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
-}
-
-static void ParseZda(const uint32_t length)
-{
-	GenericNmeaMessageT msg;
-	msg.MessageType = NMEA_MESSAGE_TYPE_ZDA;
-	TokenIterateT t;
-	TokenIteratorInit(&t, ',', packetBuffer + 6, length - 6);
-
-	msg.Zda.Valid = 1;
-
-	// Time
-	if (!ExtractTime(&t, &msg.Zda.Time))
-	{
-		msg.Zda.Valid = 0;
-	}
-
-	// Day
-	if (!ExtractByteInt(&t, (int8_t*)&msg.Zda.Day))
-	{
-		msg.Zda.Valid = 0;
-	}
-
-	// Month
-	if (!ExtractByteInt(&t, (int8_t*)&msg.Zda.Month))
-	{
-		msg.Zda.Valid = 0;
-	}
-
-	// Year
-	if (!ExtractInt(&t, (int32_t*)&msg.Zda.Year))
-	{
-		msg.Zda.Valid = 0;
-	}
-
-	// Try to queue it
-	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
-}
-
-QueueHandle_t* Nmea0183GetQueue(void)
-{
-	return NmeaMessageQueue;
+/*
+	Simple NMEA183 parser
+		-- Chris Seto, 2018
+
+	Resources
+		* http://www.gpsinformation.org/dale/nmea.htm
+*/
+
+#include <stm32f4xx_hal.h>
+#include <string.h>
+#include "Helpers.h"
+#include "TokenIterate.h"
+#include "Nmea0183.h"
+#include "LowPower.h"
+#include "Clock.h"
+#include "UbloxNeo.h"
+#include "GpsAiding.h"
+#include "Ring.h"
+
+// Sentence processors
+static void ParseGsa(const TokenTableT* t);
+static void ParseGga(const TokenTableT* t);
+static void ParseRmc(const TokenTableT* t);
+static void ParseZda(const TokenTableT* t);
+static void ParseGsv(const TokenTableT* t);
+static void ParseVtg(const TokenTableT* t);
+static void ParseGll(const TokenTableT* t);
+static void ProcessSentence(const uint8_t* sentence, const uint32_t length);
+static void DispatchInit(void);
+static void ProcessUbx(const uint8_t* frame, const uint32_t length);
+
+// Packet extractors, fields are numbered as in the sentence descriptions, 0 is the address
+static uint8_t ExtractTime(const TokenTableT* t, const uint32_t field, NmeaTimeT* time);
+static uint8_t ExtractDate(const TokenTableT* t, const uint32_t field, NmeaDateT* date);
+static uint8_t ExtractPosition(const TokenTableT* t, const uint32_t field, NmeaPositionT* pos);
+static uint8_t ExtractChar(const TokenTableT* t, const uint32_t field, uint8_t* c);
+static uint8_t ExtractFloat(const TokenTableT* t, const uint32_t field, float* x);
+static uint8_t ExtractInt(const TokenTableT* t, const uint32_t field, int32_t* x);
+
+// Field numbers
+#define RMC_TIME				1
+#define RMC_STATUS				2
+#define RMC_POSITION			3
+#define RMC_SPEED				7
+#define RMC_TRACK				8
+#define RMC_DATE				9
+
+#define GGA_TIME				1
+#define GGA_POSITION			2
+#define GGA_FIX					6
+#define GGA_SATS				7
+#define GGA_HDOP				8
+#define GGA_ALTITUDE			9
+#define GGA_ALTITUDE_UNITS		10
+
+#define ZDA_TIME				1
+#define ZDA_DAY					2
+#define ZDA_MONTH				3
+#define ZDA_YEAR				4
+
+#define GSA_FIX_MODE			2
+#define GSA_FIRST_PRN			3
+#define GSA_PRN_COUNT			12
+#define GSA_PDOP				15
+#define GSA_HDOP				16
+#define GSA_VDOP				17
+
+#define GSV_TOTAL				1
+#define GSV_NUMBER				2
+#define GSV_IN_VIEW				3
+#define GSV_FIRST_CNR			7
+#define GSV_SAT_FIELDS			4
+#define GSV_SATS_PER_SENTENCE	4
+
+#define VTG_TRACK				1
+#define VTG_SPEED				5
+#define VTG_MODE				9
+
+#define GLL_POSITION			1
+#define GLL_TIME				5
+#define GLL_STATUS				6
+
+typedef struct
+{
+	enum NMEA_MESSAGE_TYPE Type;
+	char Sentence[4];
+	void(*Processor)(const TokenTableT*);
+	TickType_t LastMsgTime;
+} NmeaProcessorT;
+
+// Task
+static void Nmea0183Task(void * pvParameters);
+static TaskHandle_t nmeaTaskHandle = NULL;
+
+// Parse anyway if we haven't been woken in this long
+#define NMEA_WAKE_TIMEOUT		1000
+
+// Serial DMA buffer, as a ring with the DMA for its producer
+// The DMA writes wherever NDTR says, the interrupts publish that as the ring head
+// Sentences are framed and parsed right where the DMA left them
+// Even at 115200 the DMA takes ~90ms of solid traffic to lap the buffer, and the HT/TC wakeups keep us well ahead of it
+#define DMA_BUFFER_SIZE			1024
+static uint8_t dmaBuffer[DMA_BUFFER_SIZE];
+static RingT dmaRing;
+
+// Message output queue
+static QueueHandle_t NmeaMessageQueue;
+
+// Only frames that wrap around the end of the DMA buffer get copied, into here
+// Sized for the biggest UBX frame we accept, NMEA sentences are shorter
+#define NMEA_PACKET_BUFFER_SIZE	(UBX_MAX_PAYLOAD + UBX_HEADER_SIZE)
+static uint8_t packetBuffer[NMEA_PACKET_BUFFER_SIZE];
+#define NMEA_MAX_SENTENCE		100
+
+#define PARSE_STATE_HEADER		0
+#define PARSE_STATE_PAYLOAD		1
+#define PARSE_STATE_CHECKSUM0	2
+#define PARSE_STATE_CHECKSUM1	3
+#define PARSE_STATE_UBX_SYNC	4
+#define PARSE_STATE_UBX_HEADER	5
+#define PARSE_STATE_UBX_PAYLOAD	6
+#define PARSE_STATE_UBX_CK_A	7
+#define PARSE_STATE_UBX_CK_B	8
+
+// Scanner state, kept between wake ups since a frame can straddle two bursts
+// Index and Start are offsets from the ring tail, which stays on the start of the frame being scanned
+// NMEA uses the XOR checksum, UBX the two Fletcher bytes
+typedef struct
+{
+	uint32_t State;
+	uint32_t Index;
+	uint32_t Start;
+	uint32_t Length;
+	uint32_t UbxLength;
+	uint8_t Checksum;
+	uint8_t FrameChecksum;
+	uint8_t CkA;
+	uint8_t CkB;
+} NmeaScannerT;
+
+static NmeaScannerT scanner = { PARSE_STATE_HEADER, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+// Checksum verified frames of any kind, so the link manager can tell a live link from noise
+static volatile uint32_t frameCount = 0;
+
+// NMEA processors, by sentence type, whatever the talker
+#define NMEA_PROCESSOR_COUNT	7
+static NmeaProcessorT processors[NMEA_PROCESSOR_COUNT] = {
+	{ NMEA_MESSAGE_TYPE_GSA, "GSA", ParseGsa, 0 },
+	{ NMEA_MESSAGE_TYPE_GGA, "GGA", ParseGga, 0 },
+	{ NMEA_MESSAGE_TYPE_RMC, "RMC", ParseRmc, 0 },
+	{ NMEA_MESSAGE_TYPE_ZDA, "ZDA", ParseZda, 0 },
+	{ NMEA_MESSAGE_TYPE_GSV, "GSV", ParseGsv, 0 },
+	{ NMEA_MESSAGE_TYPE_VTG, "VTG", ParseVtg, 0 },
+	{ NMEA_MESSAGE_TYPE_GLL, "GLL", ParseGll, 0 }
+};
+
+// Open addressed hash of the sentence type onto processors[], built at init
+// Power of two, and kept at least twice the processor count so probes stay short
+#define DISPATCH_BITS			4
+#define DISPATCH_SIZE			(1 << DISPATCH_BITS)
+#define DISPATCH_EMPTY			-1
+static int8_t dispatch[DISPATCH_SIZE];
+
+#define SENTENCE_KEY(s)			(((uint32_t)(s)[0] << 16) | ((uint32_t)(s)[1] << 8) | (uint32_t)(s)[2])
+
+// Message types somebody is listening for, the rest aren't even parsed
+static volatile uint32_t interest = 0xffffffff;
+
+// GSV comes in groups of up to 4 satellites a sentence, summarised here until the group is done
+static NmeaGsvT gsvSummary;
+static uint32_t gsvCnrSum;
+static int32_t gsvNext = 0;
+
+// Peripheral handles
+static UART_HandleTypeDef UartHandle;
+static DMA_HandleTypeDef hdma_rx;
+
+// USART3 hangs off APB1
+static void NmeaClockChanged(void)
+{
+	UartHandle.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK1Freq(), UartHandle.Init.BaudRate);
+}
+
+static void InitUart(void)
+{
+	// Init Uart
+	GPIO_InitTypeDef GPIO_InitStruct;
+
+	// Enable clocks
+	__GPIOB_CLK_ENABLE();
+	__USART3_CLK_ENABLE();
+	__DMA1_CLK_ENABLE();
+	
+	// Configure GPIO
+	GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Pull      = GPIO_NOPULL;
+	GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_HIGH;
+	GPIO_InitStruct.Pin       = GPIO_PIN_10 | GPIO_PIN_11;
+	GPIO_InitStruct.Alternate = GPIO_AF7_USART3;
+	HAL_GPIO_Init(GPIOB, &GPIO_InitStruct);
+	
+	// Configure the USART peripheral
+	UartHandle.Instance          = USART3;
+	UartHandle.Init.BaudRate     = 9600;
+	UartHandle.Init.WordLength   = UART_WORDLENGTH_8B;
+	UartHandle.Init.StopBits     = UART_STOPBITS_1;
+	UartHandle.Init.Parity       = UART_PARITY_NONE;
+	UartHandle.Init.HwFlowCtl    = UART_HWCONTROL_NONE;
+	UartHandle.Init.Mode         = UART_MODE_RX | UART_MODE_TX;
+
+	// Commit the USART
+	HAL_UART_Init(&UartHandle);
+	ClockRegisterCallback(NmeaClockChanged);
+
+	// DMA USART3
+	// RX: (DMA1, Stream 1, channel 4)
+	// TX: (DMA1, Stream 3, Channel 4), (DMA1, Stream 4, Channel 7)
+	hdma_rx.Instance                 = DMA1_Stream1;
+	hdma_rx.Init.Channel             = DMA_CHANNEL_4;
+	hdma_rx.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+	hdma_rx.Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdma_rx.Init.MemInc              = DMA_MINC_ENABLE;
+	hdma_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma_rx.Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdma_rx.Init.Mode                = DMA_CIRCULAR;
+	hdma_rx.Init.Priority            = DMA_PRIORITY_HIGH;
+	hdma_rx.Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+	hdma_rx.Init.FIFOThreshold       = DMA_FIFO_THRESHOLD_FULL;
+	hdma_rx.Init.MemBurst            = DMA_MBURST_SINGLE;
+	hdma_rx.Init.PeriphBurst         = DMA_PBURST_SINGLE;
+
+	// Init DMA
+	HAL_DMA_Init(&hdma_rx);
+
+	// Link DMA
+	__HAL_LINKDMA(&UartHandle, hdmarx, hdma_rx);
+
+	// Start DMA
+	RingInit(&dmaRing, dmaBuffer, DMA_BUFFER_SIZE);
+	HAL_UART_Receive_DMA(&UartHandle, (uint8_t*)&dmaBuffer, DMA_BUFFER_SIZE);
+
+	// Wake the parser when the line goes idle at the end of a burst
+	__HAL_UART_ENABLE_IT(&UartHandle, UART_IT_IDLE);
+	HAL_NVIC_SetPriority(USART3_IRQn, 0xf, 0xf);
+	HAL_NVIC_EnableIRQ(USART3_IRQn);
+
+	// And at half/full DMA, so a long burst can't lap the parser
+	HAL_NVIC_SetPriority(DMA1_Stream1_IRQn, 0xf, 0xf);
+	HAL_NVIC_EnableIRQ(DMA1_Stream1_IRQn);
+}
+
+UART_HandleTypeDef* Nmea0183GetUartHandle(void)
+{
+	return &UartHandle;
+}
+
+// Move our end of the GPS link to a new baud rate
+void Nmea0183SetBaudRate(const uint32_t baudRate)
+{
+	// Let anything we're sending finish at the old rate
+	while (!__HAL_UART_GET_FLAG(&UartHandle, UART_FLAG_TC))
+	{
+	}
+
+	UartHandle.Init.BaudRate = baudRate;
+	UartHandle.Instance->BRR = UART_BRR_SAMPLING16(HAL_RCC_GetPCLK1Freq(), baudRate);
+}
+
+uint32_t Nmea0183GetFrameCount(void)
+{
+	return frameCount;
+}
+
+// Say which message types to queue, as a mask of NMEA_INTEREST()
+void Nmea0183SetInterest(const uint32_t mask)
+{
+	interest = mask;
+}
+
+uint8_t Nmea0183Init(void)
+{
+	// Init RTOS queue
+	NmeaMessageQueue = xQueueCreate(10, sizeof(GenericNmeaMessageT));
+
+	if (NmeaMessageQueue == NULL)
+	{
+		return 0;
+	}
+
+	// The receiver streams continuously, STOP mode would lose bytes
+	// GpsDuty drops this while the receiver is asleep
+	LowPowerLock(LOW_POWER_LOCK_GPS);
+
+	// Sentence lookup
+	DispatchInit();
+
+	// Start serial port
+	InitUart();
+
+	return 1;
+}
+
+void Nmea0183StartParser(void)
+{
+	// Start Task
+	xTaskCreate(Nmea0183Task,
+		"Nmea0183ParserTask",
+		256,
+		NULL,
+		6,
+		&nmeaTaskHandle);
+}
+
+// Publish how far the DMA has written as the ring head
+// UART and DMA interrupts only, both at the same priority so one publishes at a time
+// HT and TC fire every half lap, so the head never falls a whole lap behind
+static void PublishDma(void)
+{
+	uint32_t position = (DMA_BUFFER_SIZE - DMA1_Stream1->NDTR) & (DMA_BUFFER_SIZE - 1);
+
+	RingCommit(&dmaRing, (position - dmaRing.Head) & (DMA_BUFFER_SIZE - 1));
+}
+
+// Get a contiguous view of a verified frame
+// Frames are normally parsed in place, only one that wraps the end of the ring gets stitched together
+static const uint8_t* FrameSpan(const uint32_t start, const uint32_t length)
+{
+	uint32_t spanLength;
+	const uint8_t* span = RingReadSpan(&dmaRing, start, &spanLength);
+
+	if (span != NULL && spanLength >= length)
+	{
+		return span;
+	}
+
+	RingCopy(&dmaRing, start, packetBuffer, length);
+
+	return packetBuffer;
+}
+
+// Frame NMEA sentences and UBX packets in the DMA ring up to where the DMA has written
+// Checksums are accumulated as we go, so every byte is looked at exactly once
+static void ScanDma(void)
+{
+	const uint8_t* span;
+	uint32_t spanLength;
+	uint32_t release;
+	uint32_t i;
+	uint8_t workingByte;
+
+	// We fell a lap behind, whatever we were in the middle of has been written over
+	if (RingCount(&dmaRing) >= DMA_BUFFER_SIZE)
+	{
+		RingConsume(&dmaRing, RingCount(&dmaRing));
+		scanner.State = PARSE_STATE_HEADER;
+		scanner.Index = 0;
+	}
+
+	while ((span = RingReadSpan(&dmaRing, scanner.Index, &spanLength)) != NULL)
+	{
+		// Up to the end of the buffer, then round again for the rest
+		for (i = 0; i < spanLength; i++)
+		{
+			workingByte = span[i];
+			scanner.Index++;
+
+			// Outside of a binary payload, a start byte always starts a fresh frame
+			if (scanner.State <= PARSE_STATE_UBX_SYNC)
+			{
+				if (workingByte == '$')
+				{
+					scanner.State = PARSE_STATE_PAYLOAD;
+					scanner.Start = scanner.Index;
+					scanner.Length = 0;
+					scanner.Checksum = 0;
+					continue;
+				}
+
+				if (workingByte == UBX_SYNC_1)
+				{
+					scanner.State = PARSE_STATE_UBX_SYNC;
+					continue;
+				}
+			}
+
+			// State machine parser
+			switch (scanner.State)
+			{
+				// Look for header byte $ or the UBX sync
+				case PARSE_STATE_HEADER:
+					break;
+
+				// Wait until we get past the payload
+				case PARSE_STATE_PAYLOAD:
+					if (workingByte == '*')
+					{
+						scanner.State = PARSE_STATE_CHECKSUM0;
+					}
+					else if (scanner.Length >= NMEA_MAX_SENTENCE)
+					{
+						// Nothing legitimate is this long, we lost the end of it
+						scanner.State = PARSE_STATE_HEADER;
+					}
+					else
+					{
+						scanner.Checksum ^= workingByte;
+						scanner.Length++;
+					}
+					break;
+
+				// First checksum byte
+				case PARSE_STATE_CHECKSUM0:
+					scanner.FrameChecksum = (Hex2int(workingByte) << 4);
+					scanner.State = PARSE_STATE_CHECKSUM1;
+					break;
+
+				// Second checksum byte
+				case PARSE_STATE_CHECKSUM1:
+					scanner.FrameChecksum |= Hex2int(workingByte);
+
+					if (scanner.FrameChecksum == scanner.Checksum)
+					{
+						frameCount++;
+						ProcessSentence(FrameSpan(scanner.Start, scanner.Length), scanner.Length);
+					}
+
+					// Reset
+					scanner.State = PARSE_STATE_HEADER;
+					break;
+
+				// Second UBX sync byte
+				case PARSE_STATE_UBX_SYNC:
+					if (workingByte == UBX_SYNC_2)
+					{
+						scanner.State = PARSE_STATE_UBX_HEADER;
+						scanner.Start = scanner.Index;
+						scanner.Length = 0;
+						scanner.CkA = 0;
+						scanner.CkB = 0;
+					}
+					else
+					{
+						scanner.State = PARSE_STATE_HEADER;
+					}
+					break;
+
+				// Class, id and little endian length
+				case PARSE_STATE_UBX_HEADER:
+					scanner.CkA += workingByte;
+					scanner.CkB += scanner.CkA;
+
+					// Pick the length up as it goes past
+					if (scanner.Length == 2)
+					{
+						scanner.UbxLength = workingByte;
+					}
+					else if (scanner.Length == 3)
+					{
+						scanner.UbxLength |= (workingByte << 8);
+					}
+
+					if (++scanner.Length < UBX_HEADER_SIZE)
+					{
+						break;
+					}
+
+					if (scanner.UbxLength > UBX_MAX_PAYLOAD)
+					{
+						// Not something we want, or not a real frame
+						scanner.State = PARSE_STATE_HEADER;
+					}
+					else
+					{
+						scanner.State = scanner.UbxLength ? PARSE_STATE_UBX_PAYLOAD : PARSE_STATE_UBX_CK_A;
+					}
+					break;
+
+				case PARSE_STATE_UBX_PAYLOAD:
+					scanner.CkA += workingByte;
+					scanner.CkB += scanner.CkA;
+
+					if (++scanner.Length == UBX_HEADER_SIZE + scanner.UbxLength)
+					{
+						scanner.State = PARSE_STATE_UBX_CK_A;
+					}
+					break;
+
+				case PARSE_STATE_UBX_CK_A:
+					scanner.State = (workingByte == scanner.CkA) ? PARSE_STATE_UBX_CK_B : PARSE_STATE_HEADER;
+					break;
+
+				case PARSE_STATE_UBX_CK_B:
+					if (workingByte == scanner.CkB)
+					{
+						frameCount++;
+						ProcessUbx(FrameSpan(scanner.Start, scanner.Length), scanner.Length);
+					}
+
+					scanner.State = PARSE_STATE_HEADER;
+					break;
+			}
+		}
+	}
+
+	// Hand back everything before the frame we're part way through
+	release = (scanner.State == PARSE_STATE_HEADER || scanner.State == PARSE_STATE_UBX_SYNC) ? scanner.Index : scanner.Start;
+	RingConsume(&dmaRing, release);
+	scanner.Index -= release;
+	scanner.Start -= release;
+}
+
+// Parse NMEA
+static void Nmea0183Task(void * pvParameters)
+{
+	// Parse NMEA
+	while (1)
+	{
+		// Block until the UART has something for us
+		ulTaskNotifyTake(pdTRUE, NMEA_WAKE_TIMEOUT);
+
+		// Frame whatever has arrived
+		ScanDma();
+	}
+}
+
+// Handle GPS UART idle line
+void USART3_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	// Idle line or a line error. Reading SR then DR clears any of them
+	if (USART3->SR & (USART_SR_IDLE | USART_SR_ORE | USART_SR_NE | USART_SR_FE | USART_SR_PE))
+	{
+		__HAL_UART_CLEAR_PEFLAG(&UartHandle);
+		PublishDma();
+		vTaskNotifyGiveFromISR(nmeaTaskHandle, &xHigherPriorityTaskWoken);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// Handle GPS UART RX DMA
+void DMA1_Stream1_IRQHandler(void)
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	// Handle full transfer complete
+	if (__HAL_DMA_GET_FLAG(&hdma_rx, DMA_FLAG_TCIF1_5))
+	{
+		__HAL_DMA_CLEAR_FLAG(&hdma_rx, DMA_FLAG_TCIF1_5);
+		PublishDma();
+		vTaskNotifyGiveFromISR(nmeaTaskHandle, &xHigherPriorityTaskWoken);
+	}
+
+	// Handle half transfer complete
+	if (__HAL_DMA_GET_FLAG(&hdma_rx, DMA_FLAG_HTIF1_5))
+	{
+		__HAL_DMA_CLEAR_FLAG(&hdma_rx, DMA_FLAG_HTIF1_5);
+		PublishDma();
+		vTaskNotifyGiveFromISR(nmeaTaskHandle, &xHigherPriorityTaskWoken);
+	}
+
+	// Handle transfer error 
+	if (__HAL_DMA_GET_FLAG(&hdma_rx, DMA_FLAG_TEIF1_5))
+	{
+		__HAL_DMA_CLEAR_FLAG(&hdma_rx, DMA_FLAG_TEIF1_5);
+	}
+
+	// FIFO error (?)
+	if (__HAL_DMA_GET_FLAG(&hdma_rx, DMA_FLAG_FEIF1_5))
+	{
+		__HAL_DMA_CLEAR_FLAG(&hdma_rx, DMA_FLAG_FEIF1_5);
+	}
+
+	portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+// Fibonacci hash, the top bits of the product are the best mixed
+static uint32_t DispatchHash(const uint32_t key)
+{
+	return (uint32_t)(key * 2654435761U) >> (32 - DISPATCH_BITS);
+}
+
+static void DispatchInit(void)
+{
+	uint32_t i;
+	uint32_t slot;
+
+	memset(dispatch, DISPATCH_EMPTY, sizeof(dispatch));
+
+	for (i = 0; i < NMEA_PROCESSOR_COUNT; i++)
+	{
+		slot = DispatchHash(SENTENCE_KEY(processors[i].Sentence));
+
+		while (dispatch[slot] != DISPATCH_EMPTY)
+		{
+			slot = (slot + 1) & (DISPATCH_SIZE - 1);
+		}
+
+		dispatch[slot] = i;
+	}
+}
+
+// Returns the processor index or DISPATCH_EMPTY
+static int32_t DispatchFind(const uint32_t key)
+{
+	uint32_t slot = DispatchHash(key);
+	int32_t i;
+
+	while ((i = dispatch[slot]) != DISPATCH_EMPTY)
+	{
+		if (SENTENCE_KEY(processors[i].Sentence) == key)
+		{
+			return i;
+		}
+
+		slot = (slot + 1) & (DISPATCH_SIZE - 1);
+	}
+
+	return DISPATCH_EMPTY;
+}
+
+static void ProcessSentence(const uint8_t* sentence, const uint32_t length)
+{
+	int32_t i;
+	TokenTableT t;
+
+	// Address is a 2 letter talker then the 3 letter type, proprietary sentences don't fit that
+	if (length < 6 || sentence[5] != ',')
+	{
+		return;
+	}
+
+	// Try to match to a known processor
+	i = DispatchFind(SENTENCE_KEY(sentence + 2));
+
+	if (i == DISPATCH_EMPTY)
+	{
+		return;
+	}
+
+	// Nobody would read it
+	if (!(interest & NMEA_INTEREST(processors[i].Type)))
+	{
+		return;
+	}
+
+	// Find every field in one go
+	TokenTableSplit(&t, ',', sentence, length);
+
+	// Call the processor
+	processors[i].Processor(&t);
+
+	// Set the last update time
+	processors[i].LastMsgTime = xTaskGetTickCount();
+}
+
+// Handle a verified UBX frame, starting at the class byte
+static void ProcessUbx(const uint8_t* frame, const uint32_t length)
+{
+	GenericNmeaMessageT msg;
+
+	if (frame[0] == UBX_CLASS_NAV && frame[1] == UBX_ID_NAV_PVT && (interest & NMEA_INTEREST(NMEA_MESSAGE_TYPE_PVT)))
+	{
+		msg.MessageType = NMEA_MESSAGE_TYPE_PVT;
+
+		if (UbloxNeoParseNavPvt(frame + UBX_HEADER_SIZE, length - UBX_HEADER_SIZE, &msg.Pvt))
+		{
+			xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+		}
+	}
+	else if (frame[0] == UBX_CLASS_MGA && frame[1] == UBX_ID_MGA_DBD)
+	{
+		GpsAidingCaptureFrame(frame, length);
+	}
+}
+
+// Extract time
+static uint8_t ExtractTime(const TokenTableT* t, const uint32_t field, NmeaTimeT* time)
+{
+	const uint8_t* token;
+	uint32_t tokenLength;
+
+	// Get the token, check length
+	if (!TokenTableGet(t, field, &token, &tokenLength) || tokenLength < 6)
+	{
+		return 0;
+	}
+
+	// Hour
+	time->Hour = atoil(token + 0, 2);
+
+	// Minute
+	time->Minute = atoil(token + 2, 2);
+
+	// Second (might be a float)
+	time->Second = atofl(token + 4, tokenLength - 4);
+
+	return 1;
+}
+
+// Extract date
+static uint8_t ExtractDate(const TokenTableT* t, const uint32_t field, NmeaDateT* date)
+{
+	const uint8_t* token;
+	uint32_t tokenLength;
+
+	// Get the token, check length
+	if (!TokenTableGet(t, field, &token, &tokenLength) || tokenLength < 6)
+	{
+		return 0;
+	}
+
+	// Day
+	date->Day = atoil(token + 0, 2);
+
+	// Month
+	date->Month = atoil(token + 2, 2);
+
+	// Year
+	date->Year = atoil(token + 4, tokenLength - 4);
+
+	return 1;
+}
+
+// Parse a [d]ddmm.mmmmm coordinate into 1e-7 degrees, integer only
+// Minutes are kept to 7 decimals before the divide by 60, so nothing the receiver gives us is lost
+static uint8_t ParseCoordinate(const uint8_t* token, const uint32_t tokenLength, const uint32_t degreeDigits, int32_t* coordinate)
+{
+	uint32_t i;
+	uint32_t digits = 0;
+	int32_t minutes;
+	uint8_t d;
+
+	// Need at least the degrees and whole minutes
+	if (tokenLength < degreeDigits + 2)
+	{
+		return 0;
+	}
+
+	// Whole minutes
+	minutes = atoil(token + degreeDigits, 2);
+
+	// Fractional minutes, scaled to 1e-7 minutes
+	i = degreeDigits + 2;
+
+	if (i < tokenLength && token[i] == '.')
+	{
+		i++;
+	}
+
+	for (; i < tokenLength && digits < 7; i++, digits++)
+	{
+		d = token[i] - '0';
+
+		if (d > 9)
+		{
+			return 0;
+		}
+
+		minutes = minutes * 10 + d;
+	}
+
+	for (; digits < 7; digits++)
+	{
+		minutes *= 10;
+	}
+
+	*coordinate = atoil(token, degreeDigits) * 10000000 + (minutes + 30) / 60;
+
+	return 1;
+}
+
+// Extract position, in 1e-7 degrees
+// Takes four fields from field: lat, N/S, lon, E/W
+static uint8_t ExtractPosition(const TokenTableT* t, const uint32_t field, NmeaPositionT* pos)
+{
+	const uint8_t* token;
+	uint32_t tokenLength;
+	uint8_t dir;
+
+	// Lat
+	if (!TokenTableGet(t, field, &token, &tokenLength) || !ParseCoordinate(token, tokenLength, 2, &pos->Lat))
+	{
+		return 0;
+	}
+
+	// Get direction
+	if (!ExtractChar(t, field + 1, &dir))
+	{
+		return 0;
+	}
+
+	if (dir != 'N')
+	{
+		pos->Lat = -pos->Lat;
+	}
+
+	// Lon
+	if (!TokenTableGet(t, field + 2, &token, &tokenLength) || !ParseCoordinate(token, tokenLength, 3, &pos->Lon))
+	{
+		return 0;
+	}
+
+	// Get direction
+	if (!ExtractChar(t, field + 3, &dir))
+	{
+		return 0;
+	}
+
+	if (dir != 'E')
+	{
+		pos->Lon = -pos->Lon;
+	}
+
+	return 1;
+}
+
+// Extract char
+static uint8_t ExtractChar(const TokenTableT* t, const uint32_t field, uint8_t* c)
+{
+	const uint8_t* token;
+	uint32_t tokenLength;
+
+	// Get the token, check length
+	if (!TokenTableGet(t, field, &token, &tokenLength) || tokenLength != 1)
+	{
+		*c = 0;
+		return 0;
+	}
+
+	*c = token[0];
+
+	return 1;
+}
+
+// Extract float
+static uint8_t ExtractFloat(const TokenTableT* t, const uint32_t field, float* x)
+{
+	const uint8_t* token;
+	uint32_t tokenLength;
+
+	// Get the token
+	if (!TokenTableGet(t, field, &token, &tokenLength))
+	{
+		*x = 0;
+		return 0;
+	}
+
+	*x = atofl(token, tokenLength);
+
+	return 1;
+}
+
+// Extract int
+static uint8_t ExtractInt(const TokenTableT* t, const uint32_t field, int32_t* x)
+{
+	const uint8_t* token;
+	uint32_t tokenLength;
+
+	// Get the token
+	if (!TokenTableGet(t, field, &token, &tokenLength))
+	{
+		*x = 0;
+		return 0;
+	}
+
+	*x = atoil(token, tokenLength);
+
+	return 1;
+}
+
+//// Sentence Parsers ////
+
+static void ParseGsa(const TokenTableT* t)
+{
+	/*
+		$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39
+
+		Where:
+			 GSA      Satellite status
+			 A        Auto selection of 2D or 3D fix (M = manual) 
+			 3        3D fix - values include: 1 = no fix
+											   2 = 2D fix
+											   3 = 3D fix
+			 04,05... PRNs of satellites used for fix (space for 12) 
+			 2.5      PDOP (dilution of precision) 
+			 1.3      Horizontal dilution of precision (HDOP) 
+			 2.1      Vertical dilution of precision (VDOP)
+			 *39      the checksum data, always begins with *
+
+	*/
+
+	GenericNmeaMessageT msg;
+	const uint8_t* token;
+	uint32_t tokenLength;
+	int32_t mode;
+	uint32_t i;
+	memset(&msg, 0, sizeof(GenericNmeaMessageT));
+	msg.MessageType = NMEA_MESSAGE_TYPE_GSA;
+
+	// Fix mode is the one thing we can't do without
+	if (!ExtractInt(t, GSA_FIX_MODE, &mode))
+	{
+		return;
+	}
+
+	msg.Gsa.Mode = mode;
+
+	// Count the used satellites, unused slots are empty
+	msg.Gsa.SatsUsed = 0;
+
+	for (i = 0; i < GSA_PRN_COUNT; i++)
+	{
+		if (TokenTableGet(t, GSA_FIRST_PRN + i, &token, &tokenLength))
+		{
+			msg.Gsa.SatsUsed++;
+		}
+	}
+
+	// DOPs, an empty one stays at 0 and objects to nothing
+	ExtractFloat(t, GSA_PDOP, &msg.Gsa.PDop);
+	ExtractFloat(t, GSA_HDOP, &msg.Gsa.HDop);
+	ExtractFloat(t, GSA_VDOP, &msg.Gsa.VDop);
+
+	// Try to queue it
+	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+}
+
+static void ParseRmc(const TokenTableT* t)
+{
+	/*
+	$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A
+
+	Where:
+		 RMC          Recommended Minimum sentence C
+		 123519       Fix taken at 12:35:19 UTC
+		 A            Status A=active or V=Void.
+		 4807.038,N   Latitude 48 deg 07.038' N
+		 01131.000,E  Longitude 11 deg 31.000' E
+		 022.4        Speed over the ground in knots
+		 084.4        Track angle in degrees True
+		 230394       Date - 23rd of March 1994
+		 003.1,W      Magnetic Variation
+		 *6A          The checksum data, always begins with *
+
+	*/
+
+	GenericNmeaMessageT msg;
+	memset(&msg, 0, sizeof(GenericNmeaMessageT));
+	msg.MessageType = NMEA_MESSAGE_TYPE_RMC;
+
+	// Any field can be empty, each one says whether it was there
+	// Time
+	msg.Rmc.TimeValid = ExtractTime(t, RMC_TIME, &msg.Rmc.Time);
+
+	// Fix
+	ExtractChar(t, RMC_STATUS, &msg.Rmc.Fix);
+
+	// Position
+	msg.Rmc.PositionValid = ExtractPosition(t, RMC_POSITION, &msg.Rmc.Position);
+
+	// Speed and track, track is left empty when there's too little speed to have one
+	msg.Rmc.VelocityValid = ExtractFloat(t, RMC_SPEED, &msg.Rmc.Speed)
+		& ExtractFloat(t, RMC_TRACK, &msg.Rmc.Track);
+
+	// Date
+	ExtractDate(t, RMC_DATE, &msg.Rmc.Date);
+	
+	// Try to queue it
+	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+}
+
+static void ParseGga(const TokenTableT* t)
+{
+	/*
+		$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47
+
+		Where:
+			GGA          Global Positioning System Fix Data
+			123519       Fix taken at 12:35:19 UTC
+			4807.038,N   Latitude 48 deg 07.038' N
+			01131.000,E  Longitude 11 deg 31.000' E
+			1            Fix quality: 0 = invalid
+									1 = GPS fix (SPS)
+									2 = DGPS fix
+									3 = PPS fix
+						4 = Real Time Kinematic
+						5 = Float RTK
+									6 = estimated (dead reckoning) (2.3 feature)
+						7 = Manual input mode
+						8 = Simulation mode
+			08           Number of satellites being tracked
+			0.9          Horizontal dilution of position
+			545.4,M      Altitude, Meters, above mean sea level
+			46.9,M       Height of geoid (mean sea level) above WGS84
+							ellipsoid
+			(empty field) time in seconds since last DGPS update
+			(empty field) DGPS station ID number
+			*47          the checksum data, always begins with *
+	*/
+
+	GenericNmeaMessageT msg;
+	memset(&msg, 0, sizeof(GenericNmeaMessageT));
+	msg.MessageType = NMEA_MESSAGE_TYPE_GGA;
+
+	// Any field can be empty, each one says whether it was there
+	// Time
+	msg.Gga.TimeValid = ExtractTime(t, GGA_TIME, &msg.Gga.Time);
+
+	// Position
+	msg.Gga.PositionValid = ExtractPosition(t, GGA_POSITION, &msg.Gga.Position);
+
+	// Fix
+	ExtractChar(t, GGA_FIX, &msg.Gga.Fix);
+
+	// Sats tracked
+	ExtractInt(t, GGA_SATS, &msg.Gga.SatCount);
+
+	// HDOP
+	msg.Gga.HDopValid = ExtractFloat(t, GGA_HDOP, &msg.Gga.HDop);
+
+	// Altitude
+	msg.Gga.AltitudeValid = ExtractFloat(t, GGA_ALTITUDE, &msg.Gga.Altitude);
+
+	// Altitude units
+	ExtractChar(t, GGA_ALTITUDE_UNITS, &msg.Gga.AltitudeUnits);
+
+	// Try to queue it
+	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+}
+
+static void ParseZda(const TokenTableT* t)
+{
+	GenericNmeaMessageT msg;
+	int32_t day;
+	int32_t month;
+	int32_t year;
+	msg.MessageType = NMEA_MESSAGE_TYPE_ZDA;
+
+	// Every field has to be there
+	msg.Zda.Valid = ExtractTime(t, ZDA_TIME, &msg.Zda.Time)
+		& ExtractInt(t, ZDA_DAY, &day)
+		& ExtractInt(t, ZDA_MONTH, &month)
+		& ExtractInt(t, ZDA_YEAR, &year);
+
+	msg.Zda.Day = day;
+	msg.Zda.Month = month;
+	msg.Zda.Year = year;
+
+	// Try to queue it
+	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+}
+
+static void ParseGsv(const TokenTableT* t)
+{
+	/*
+		$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75
+
+		Where:
+			GSV          Satellites in view
+			2            Number of sentences for full data
+			1            Sentence 1 of 2
+			08           Number of satellites in view
+			01           Satellite PRN number
+			40           Elevation, degrees
+			083          Azimuth, degrees
+			46           CNR, dBHz, empty when not tracking
+			<repeat for up to 4 satellites per sentence>
+	*/
+
+	GenericNmeaMessageT msg;
+	const uint8_t* token;
+	uint32_t tokenLength;
+	int32_t total;
+	int32_t number;
+	int32_t value;
+	uint32_t i;
+
+	if (!ExtractInt(t, GSV_TOTAL, &total) || !ExtractInt(t, GSV_NUMBER, &number))
+	{
+		return;
+	}
+
+	// A group always starts over at 1
+	if (number == 1)
+	{
+		memset(&gsvSummary, 0, sizeof(NmeaGsvT));
+		gsvCnrSum = 0;
+
+		TokenTableGet(t, 0, &token, &tokenLength);
+		gsvSummary.Talker[0] = token[0];
+		gsvSummary.Talker[1] = token[1];
+
+		ExtractInt(t, GSV_IN_VIEW, &value);
+		gsvSummary.InView = value;
+	}
+	else if (number != gsvNext)
+	{
+		// Lost part of the group, wait for the next one
+		gsvNext = 0;
+		return;
+	}
+
+	gsvNext = number + 1;
+
+	// Summarise the satellites actually being tracked
+	for (i = 0; i < GSV_SATS_PER_SENTENCE; i++)
+	{
+		if (ExtractInt(t, GSV_FIRST_CNR + i * GSV_SAT_FIELDS, &value))
+		{
+			gsvSummary.Tracked++;
+			gsvCnrSum += value;
+
+			if (value > gsvSummary.MaxCnr)
+			{
+				gsvSummary.MaxCnr = value;
+			}
+		}
+	}
+
+	// Last of the group
+	if (number == total)
+	{
+		gsvNext = 0;
+		gsvSummary.MeanCnr = gsvSummary.Tracked ? gsvCnrSum / gsvSummary.Tracked : 0;
+
+		msg.MessageType = NMEA_MESSAGE_TYPE_GSV;
+		msg.Gsv = gsvSummary;
+
+		// Try to queue it
+		xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+	}
+}
+
+static void ParseVtg(const TokenTableT* t)
+{
+	/*
+		$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A*25
+
+		Where:
+			VTG          Track made good and ground speed
+			054.7,T      True track made good (degrees)
+			034.4,M      Magnetic track made good
+			005.5,N      Ground speed, knots
+			010.2,K      Ground speed, Kilometers per hour
+			A            Mode, N = not valid (NMEA 2.3 and later)
+	*/
+
+	GenericNmeaMessageT msg;
+	memset(&msg, 0, sizeof(GenericNmeaMessageT));
+	msg.MessageType = NMEA_MESSAGE_TYPE_VTG;
+
+	// Track and speed, track is left empty when there's too little speed to have one
+	msg.Vtg.TrackValid = ExtractFloat(t, VTG_TRACK, &msg.Vtg.Track);
+
+	if (!ExtractFloat(t, VTG_SPEED, &msg.Vtg.Speed))
+	{
+		return;
+	}
+
+	// Older receivers have no mode, take them at their word
+	if (!ExtractChar(t, VTG_MODE, &msg.Vtg.Mode))
+	{
+		msg.Vtg.Mode = 'A';
+	}
+
+	// Try to queue it
+	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+}
+
+static void ParseGll(const TokenTableT* t)
+{
+	/*
+		$GPGLL,4916.45,N,12311.12,W,225444,A,A*5C
+
+		Where:
+			GLL          Geographic position, Latitude and Longitude
+			4916.46,N    Latitude 49 deg. 16.45 min. North
+			12311.12,W   Longitude 123 deg. 11.12 min. West
+			225444       Fix taken at 22:54:44 UTC
+			A            Data Active or V (void)
+	*/
+
+	GenericNmeaMessageT msg;
+	memset(&msg, 0, sizeof(GenericNmeaMessageT));
+	msg.MessageType = NMEA_MESSAGE_TYPE_GLL;
+
+	if (!ExtractPosition(t, GLL_POSITION, &msg.Gll.Position))
+	{
+		return;
+	}
+
+	msg.Gll.TimeValid = ExtractTime(t, GLL_TIME, &msg.Gll.Time);
+	ExtractChar(t, GLL_STATUS, &msg.Gll.Status);
+
+	// Try to queue it
+	xQueueSendToBack(NmeaMessageQueue, &msg, 0);
+}
+
+QueueHandle_t* Nmea0183GetQueue(void)
+{
+	return NmeaMessageQueue;
 }
\ No newline at end of file
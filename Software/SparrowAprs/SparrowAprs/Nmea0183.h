@@ -1,85 +1,162 @@
-#ifndef NMEA_H
-#define NMEA_H
-
-#include <stm32f4xx_hal.h>
-#include "FreeRTOS.h"
-#include "task.h"
-#include "queue.h"
-
-#include <stdint.h>
-
-typedef struct
-{
-	uint8_t Hour;
-	uint8_t Minute;
-	float Second;
-} NmeaTimeT;
-
-typedef struct
-{
-	uint8_t Day;
-	uint8_t Month;
-	uint8_t Year;
-} NmeaDateT;
-
-typedef struct
-{
-	float Lat;
-	float Lon;
-} NmeaPositionT;
-
-typedef struct
-{
-	NmeaTimeT Time;
-	NmeaPositionT Position;
-	uint8_t Fix;
-	int32_t SatCount;
-	float HDop;
-	float Altitude;
-	uint8_t AltitudeUnits;
-} NmeaGgaT;
-
-typedef struct
-{
-	NmeaTimeT Time;
-	uint8_t Fix;
-	NmeaPositionT Position;
-	float Speed;
-	float Track;
-	NmeaDateT Date;
-} NmeaRmcT;
-
-typedef struct
-{
-	NmeaTimeT Time;
-	uint8_t Day;
-	uint8_t Month;
-	uint32_t Year;
-	uint8_t Valid;
-} NmeaZdaT;
-
-enum NMEA_MESSAGE_TYPE
-{
-	NMEA_MESSAGE_TYPE_GGA,
-	NMEA_MESSAGE_TYPE_RMC,
-	NMEA_MESSAGE_TYPE_GSA,
-	NMEA_MESSAGE_TYPE_ZDA
-};
-
-typedef struct
-{
-	enum NMEA_MESSAGE_TYPE MessageType;
-	union
-	{
-		NmeaGgaT Gga;
-		NmeaRmcT Rmc;
-		NmeaZdaT Zda;
-	};
-} GenericNmeaMessageT;
-
-uint8_t Nmea0183Init(void);
-void Nmea0183StartParser(void);
-QueueHandle_t* Nmea0183GetQueue(void);
-UART_HandleTypeDef* Nmea0183GetUartHandle(void);
-
-#endif // !NMEA_H
+#ifndef NMEA_H
+#define NMEA_H
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include <stdint.h>
+
+typedef struct
+{
+	uint8_t Hour;
+	uint8_t Minute;
+	float Second;
+} NmeaTimeT;
+
+typedef struct
+{
+	uint8_t Day;
+	uint8_t Month;
+	uint8_t Year;
+} NmeaDateT;
+
+typedef struct
+{
+	int32_t Lat;
+	int32_t Lon;
+} NmeaPositionT;
+
+typedef struct
+{
+	NmeaTimeT Time;
+	NmeaPositionT Position;
+	uint8_t Fix;
+	int32_t SatCount;
+	float HDop;
+	float Altitude;
+	uint8_t AltitudeUnits;
+	uint8_t TimeValid;
+	uint8_t PositionValid;
+	uint8_t HDopValid;
+	uint8_t AltitudeValid;
+} NmeaGgaT;
+
+typedef struct
+{
+	NmeaTimeT Time;
+	uint8_t Fix;
+	NmeaPositionT Position;
+	float Speed;
+	float Track;
+	NmeaDateT Date;
+	uint8_t TimeValid;
+	uint8_t PositionValid;
+	uint8_t VelocityValid;
+} NmeaRmcT;
+
+typedef struct
+{
+	NmeaTimeT Time;
+	uint8_t Day;
+	uint8_t Month;
+	uint32_t Year;
+	uint8_t Valid;
+} NmeaZdaT;
+
+typedef struct
+{
+	uint8_t Mode;
+	uint8_t SatsUsed;
+	float PDop;
+	float HDop;
+	float VDop;
+} NmeaGsaT;
+
+typedef struct
+{
+	uint8_t Talker[2];
+	uint8_t InView;
+	uint8_t Tracked;
+	uint8_t MaxCnr;
+	uint8_t MeanCnr;
+} NmeaGsvT;
+
+typedef struct
+{
+	float Track;
+	float Speed;
+	uint8_t Mode;
+	uint8_t TrackValid;
+} NmeaVtgT;
+
+typedef struct
+{
+	NmeaPositionT Position;
+	NmeaTimeT Time;
+	uint8_t Status;
+	uint8_t TimeValid;
+} NmeaGllT;
+
+typedef struct
+{
+	uint32_t ITow;
+	uint16_t Year;
+	uint8_t Month;
+	uint8_t Day;
+	uint8_t Hour;
+	uint8_t Minute;
+	uint8_t Second;
+	uint8_t TimeValid;
+	uint8_t FixType;
+	uint8_t FixOk;
+	uint8_t SatCount;
+	int32_t Lat;
+	int32_t Lon;
+	int32_t AltitudeMsl;
+	int32_t GroundSpeed;
+	int32_t Heading;
+	int32_t VelocityDown;
+	uint16_t PDop;
+} UbxNavPvtT;
+
+enum NMEA_MESSAGE_TYPE
+{
+	NMEA_MESSAGE_TYPE_GGA,
+	NMEA_MESSAGE_TYPE_RMC,
+	NMEA_MESSAGE_TYPE_GSA,
+	NMEA_MESSAGE_TYPE_ZDA,
+	NMEA_MESSAGE_TYPE_PVT,
+	NMEA_MESSAGE_TYPE_GSV,
+	NMEA_MESSAGE_TYPE_VTG,
+	NMEA_MESSAGE_TYPE_GLL
+};
+
+#define NMEA_INTEREST(type)		(1UL << (type))
+
+typedef struct
+{
+	enum NMEA_MESSAGE_TYPE MessageType;
+	union
+	{
+		NmeaGgaT Gga;
+		NmeaRmcT Rmc;
+		NmeaZdaT Zda;
+		NmeaGsaT Gsa;
+		NmeaGsvT Gsv;
+		NmeaVtgT Vtg;
+		NmeaGllT Gll;
+		UbxNavPvtT Pvt;
+	};
+} GenericNmeaMessageT;
+
+uint8_t Nmea0183Init(void);
+void Nmea0183StartParser(void);
+QueueHandle_t* Nmea0183GetQueue(void);
+UART_HandleTypeDef* Nmea0183GetUartHandle(void);
+void Nmea0183SetBaudRate(const uint32_t baudRate);
+uint32_t Nmea0183GetFrameCount(void);
+void Nmea0183SetInterest(const uint32_t mask);
+
+#endif // !NMEA_H
@@ -0,0 +1,71 @@
+/*
+	Fixed size radio packet pool
+
+	Packets are allocated from a static array and only pointers are passed
+	through the radio queues. Alloc/free are lock free (a single CAS on a
+	free bitmap), so they are safe to call from tasks and ISRs alike.
+*/
+#include <stdint.h>
+#include <string.h>
+#include "Radio.h"
+#include "PacketPool.h"
+
+// Must not exceed the width of the free mask
+#define PACKET_POOL_SIZE	8
+
+static RadioPacketT pool[PACKET_POOL_SIZE];
+
+// One bit per packet, set when the packet is free
+static volatile uint32_t freeMask;
+
+void PacketPoolInit(void)
+{
+	__atomic_store_n(&freeMask, (1UL << PACKET_POOL_SIZE) - 1, __ATOMIC_RELEASE);
+}
+
+// Take a packet from the pool, returns NULL if the pool is exhausted
+RadioPacketT* PacketPoolAlloc(void)
+{
+	uint32_t mask = __atomic_load_n(&freeMask, __ATOMIC_ACQUIRE);
+	uint32_t index;
+
+	while (mask)
+	{
+		index = __builtin_ctz(mask);
+
+		// Claim the lowest free packet. If someone beat us to it, mask is reloaded and we try again
+		if (__atomic_compare_exchange_n(&freeMask, &mask, mask & ~(1UL << index), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+		{
+			pool[index].LivePosition = 0;
+			return &pool[index];
+		}
+	}
+
+	return NULL;
+}
+
+// Return a packet to the pool
+void PacketPoolFree(RadioPacketT* packet)
+{
+	uint32_t index;
+
+	if (packet == NULL)
+	{
+		return;
+	}
+
+	index = packet - pool;
+
+	// Ignore anything that did not come from the pool
+	if (index >= PACKET_POOL_SIZE)
+	{
+		return;
+	}
+
+	__atomic_fetch_or(&freeMask, 1UL << index, __ATOMIC_RELEASE);
+}
+
+uint32_t PacketPoolFreeCount(void)
+{
+	return __builtin_popcount(__atomic_load_n(&freeMask, __ATOMIC_ACQUIRE));
+}
\ No newline at end of file
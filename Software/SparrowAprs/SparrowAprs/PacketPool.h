@@ -0,0 +1,12 @@
+#ifndef PACKETPOOL_H
+#define PACKETPOOL_H
+
+#include <stdint.h>
+#include "Radio.h"
+
+void PacketPoolInit(void);
+RadioPacketT* PacketPoolAlloc(void);
+void PacketPoolFree(RadioPacketT* packet);
+uint32_t PacketPoolFreeCount(void);
+
+#endif // !PACKETPOOL_H
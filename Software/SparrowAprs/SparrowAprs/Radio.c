@@ -1,166 +1,503 @@
-#include <stm32f4xx_hal.h>
-#include "FreeRTOS.h"
-#include "task.h"
-#include <stdint.h>
-#include <string.h>
-#include "Ax25.h"
-#include "Dra818.h"
-#include "Dra818Io.h"
-#include "Audio.h"
-#include "Afsk.h"
-#include "Aprs.h"
-#include "Beacon.h"
-#include "Led.h"
-#include "Nmea0183.h"
-#include "Rtc.h"
-#include "time.h"
-#include "Radio.h"
-#include "Watchdog.h"
-
-// Message output queue
-static QueueHandle_t txQueue;
-static QueueHandle_t rxQueue;
-
-static TaskHandle_t radioTaskHandle = NULL;
-
-// Audio buffers
-#define AUDIO_BUFFER_SIZE		22000
-static uint8_t audioOut[AUDIO_BUFFER_SIZE];
-static uint8_t audioIn[AUDIO_BUFFER_SIZE];
-
-#define AX25_BUFFER_SIZE	500
-static uint8_t ax25Buffer[AX25_BUFFER_SIZE];
-
-#define TX_RX_QUEUE_SIZE	10
-
-void RadioTask(void* pvParameters);
-static void Dra818AprsInit(void);
-
-#define PTT_DOWN_DELAY		50
-#define PTT_UP_DELAY		20
-
-void RadioInit(void)
-{
-	// Init queues
-	txQueue = xQueueCreate(TX_RX_QUEUE_SIZE, sizeof(RadioPacketT));
-	rxQueue = xQueueCreate(TX_RX_QUEUE_SIZE, sizeof(RadioPacketT));
-}
-
-QueueHandle_t* RadioGetTxQueue(void)
-{
-	return txQueue;
-}
-
-QueueHandle_t* RadioGetRxQueue(void)
-{
-	return rxQueue;
-}
-
-void RadioTaskStart(void)
-{
-	// Create task
-	xTaskCreate(RadioTask,
-		"Radio",
-		300,
-		NULL,
-		7,
-		&radioTaskHandle);
-}
-
-static void Dra818AprsInit(void)
-{
-	// Bring up the module
-	Dra818IoPowerUp();
-
-	// Wait for the module to init
-	vTaskDelay(100 / portTICK_PERIOD_MS);
-
-	// Connect (to init the module?)
-	Dra818Connect();
-	vTaskDelay(100 / portTICK_PERIOD_MS);
-
-	// Configure group
-	Dra818SetGroup(144.390, 144.390, "0000", "0000", 8);
-	vTaskDelay(100 / portTICK_PERIOD_MS);
-
-	// Configure filter
-	Dra818SetFilter(1, 0, 0);
-
-	// Set RF power
-	Dra818IoSetLowRfPower();
-}
-
-// Radio manager task
-void RadioTask(void* pvParameters)
-{
-	uint32_t encodedAudioLength;
-	uint32_t ax25Len;
-	TickType_t lastTaskTime = 0;
-	RadioPacketT packetOut;
-
-	// Init DRA radio module
-	Dra818AprsInit();
-
-	// Airtime / radio management loop
-	while (1)
-	{
-		// Block until it's time to start
-		vTaskDelayUntil(&lastTaskTime, 10);
-
-		// Check if we have a packet to transmit
-		if (!xQueueIsQueueEmptyFromISR(txQueue))
-		{
-			// Get the packet
-			if(!xQueueReceive(txQueue, &packetOut, 0))
-			{
-				continue;
-			}
-
-			printf("[TX] %.*s\r\n", (int)packetOut.Frame.PayloadLength, packetOut.Payload);
-			
-			// We have something to transmit, build and encode the packet
-			packetOut.Frame.Path = packetOut.Path;
-			packetOut.Frame.Payload = packetOut.Payload;
-			ax25Len = Ax25BuildUnPacket(&packetOut.Frame, ax25Buffer);
-
-			// Audio encoding
-			encodedAudioLength = AfskHdlcEncode(ax25Buffer,
-				ax25Len,
-				packetOut.Frame.PreFlagCount,
-				ax25Len - packetOut.Frame.PostFlagCount,
-				audioOut,
-				AUDIO_BUFFER_SIZE
-			);
-
-			// If the encoded audio length is zero, the encode output buffer wasn't big enough to accomidate the entire payload
-			// It might be mission critical that this gets out in a worst case scenario
-			// So just transmit the entire buffer...
-			if (!encodedAudioLength)
-			{
-				encodedAudioLength = AUDIO_BUFFER_SIZE;
-			}
-
-			// Start xmit
-			LedOn(LED_2);
-			Dra818IoPttOn();
-			Dra818IoSetHighRfPower();
-			
-			// Wait to play until after we PTT down
-			vTaskDelay(PTT_DOWN_DELAY / portTICK_PERIOD_MS);
-
-			// Play audio
-			AudioPlay(audioOut, encodedAudioLength);
-
-			// Block while we're transmitting
-			AudioOutWait(portMAX_DELAY);
-
-			// Wait a little longer before we PTT up
-			vTaskDelay(PTT_UP_DELAY / portTICK_PERIOD_MS);
-
-			// Stop Xmit
-			Dra818IoPttOff();
-			Dra818IoSetLowRfPower();
-			LedOff(LED_2);
-		}
-	}
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdint.h>
+#include <string.h>
+#include "Ax25.h"
+#include "Dra818.h"
+#include "Dra818Io.h"
+#include "Audio.h"
+#include "Afsk.h"
+#include "Aprs.h"
+#include "Beacon.h"
+#include "Led.h"
+#include "Nmea0183.h"
+#include "Rtc.h"
+#include "time.h"
+#include "Radio.h"
+#include "PacketPool.h"
+#include "LowPower.h"
+#include "Watchdog.h"
+#include "Clock.h"
+#include "Region.h"
+#include "FlashJob.h"
+#include "Crash.h"
+
+// Transmit priority queue
+// Slots only hold pool handles, the packets themselves live in the packet pool
+// Kept smaller than the pool so there is always a packet free for a producer to evict with
+typedef struct
+{
+	RadioPacketT* Packet;
+	uint32_t Sequence;
+} TxSlotT;
+
+#define TX_QUEUE_SIZE		6
+static TxSlotT txSlots[TX_QUEUE_SIZE];
+static uint32_t txSequence = 0;
+
+// Message input queue
+static QueueHandle_t rxQueue;
+
+static TaskHandle_t radioTaskHandle = NULL;
+
+// Audio buffers
+#define AUDIO_BUFFER_SIZE		22000
+static uint8_t audioOut[AUDIO_BUFFER_SIZE];
+static uint8_t audioIn[AUDIO_BUFFER_SIZE];
+
+#define AX25_BUFFER_SIZE	500
+static uint8_t ax25Buffer[AX25_BUFFER_SIZE];
+
+#define RX_QUEUE_SIZE		4
+
+// What the DRA818 was last told, so a wake up only re-sends what changed
+// The module keeps its settings while powered down
+typedef struct
+{
+	uint8_t Valid;
+	float Frequency;
+	uint8_t Squelch;
+} RadioGroupT;
+
+typedef struct
+{
+	uint8_t Valid;
+	uint8_t Predeemphasis;
+	uint8_t Highpass;
+	uint8_t Lowpass;
+} RadioFilterT;
+
+static RadioGroupT groupApplied;
+static RadioFilterT filterApplied;
+static RadioGroupT groupPending;
+static RadioFilterT filterPending;
+static uint8_t radioChecked = 0;
+static uint8_t radioOk = 0;
+
+// Long enough for the module to boot and every command to use up its retries
+#define RADIO_READY_TIMEOUT		2000
+#define RADIO_SQUELCH			8
+
+void RadioTask(void* pvParameters);
+static void RadioPowerOn(void);
+static uint8_t RadioPowerReady(void);
+static void RadioPowerOff(void);
+static RadioPacketT* TxSlotInsert(RadioPacketT* packet, const TickType_t now);
+static RadioPacketT* TxSlotTakeNext(const TickType_t now);
+
+#define PTT_DOWN_DELAY		50
+#define PTT_UP_DELAY		20
+
+// Time on air in ms for a number of bytes at 1200 baud, bit stuffing aside
+#define AIR_TIME(bytes)		((bytes) * 8000 / 1200)
+
+// How long it takes from refreshing a position to keying up, measured on each packet
+#define ENCODE_TIME_GUESS	20
+static TickType_t encodeTime = ENCODE_TIME_GUESS;
+
+void RadioInit(void)
+{
+	// Init packet storage
+	PacketPoolInit();
+
+	// Init queues
+	memset(txSlots, 0, sizeof(txSlots));
+	rxQueue = xQueueCreate(RX_QUEUE_SIZE, sizeof(RadioPacketT*));
+}
+
+// Check if a packet's expiration deadline has passed
+// Done in signed arithmatic so that it survives the tick counter rolling over
+static uint8_t IsExpired(const RadioPacketT* packet, const TickType_t now)
+{
+	return ((int32_t)(now - packet->Expiration) >= 0);
+}
+
+// Insert a packet into the transmit queue
+// Returns whichever packet did not make it into the queue (evicted or rejected), or NULL
+// Must be called with the queue locked
+static RadioPacketT* TxSlotInsert(RadioPacketT* packet, const TickType_t now)
+{
+	uint32_t i;
+	TxSlotT* slot = NULL;
+	RadioPacketT* dropped = NULL;
+
+	for (i = 0; i < TX_QUEUE_SIZE; i++)
+	{
+		// Take the first free slot
+		if (txSlots[i].Packet == NULL)
+		{
+			slot = &txSlots[i];
+			break;
+		}
+	}
+
+	// If the queue is full, evict the least valuable packet, as long as it is worth less than this one
+	if (slot == NULL)
+	{
+		for (i = 0; i < TX_QUEUE_SIZE; i++)
+		{
+			// Anything stale can go first
+			if (IsExpired(txSlots[i].Packet, now))
+			{
+				slot = &txSlots[i];
+				break;
+			}
+
+			if (txSlots[i].Packet->Priority >= packet->Priority)
+			{
+				continue;
+			}
+
+			// Lowest priority first, oldest within that priority
+			if (slot == NULL
+				|| txSlots[i].Packet->Priority < slot->Packet->Priority
+				|| (txSlots[i].Packet->Priority == slot->Packet->Priority && (int32_t)(txSlots[i].Sequence - slot->Sequence) < 0))
+			{
+				slot = &txSlots[i];
+			}
+		}
+
+		// Everything queued is more important
+		if (slot == NULL)
+		{
+			return packet;
+		}
+
+		dropped = slot->Packet;
+	}
+
+	slot->Packet = packet;
+	slot->Sequence = txSequence++;
+
+	return dropped;
+}
+
+// Remove the most valuable fresh packet from the transmit queue
+// Expired packets are returned to the pool without ever being encoded
+static RadioPacketT* TxSlotTakeNext(const TickType_t now)
+{
+	uint32_t i;
+	TxSlotT* best = NULL;
+	RadioPacketT* packet = NULL;
+
+	taskENTER_CRITICAL();
+
+	for (i = 0; i < TX_QUEUE_SIZE; i++)
+	{
+		if (txSlots[i].Packet == NULL)
+		{
+			continue;
+		}
+
+		// Drop stale packets
+		if (IsExpired(txSlots[i].Packet, now))
+		{
+			PacketPoolFree(txSlots[i].Packet);
+			txSlots[i].Packet = NULL;
+			continue;
+		}
+
+		// Highest priority first, oldest within that priority
+		if (best == NULL
+			|| txSlots[i].Packet->Priority > best->Packet->Priority
+			|| (txSlots[i].Packet->Priority == best->Packet->Priority && (int32_t)(txSlots[i].Sequence - best->Sequence) < 0))
+		{
+			best = &txSlots[i];
+		}
+	}
+
+	if (best != NULL)
+	{
+		packet = best->Packet;
+		best->Packet = NULL;
+	}
+
+	taskEXIT_CRITICAL();
+
+	return packet;
+}
+
+// Enqueue a pool packet for transmission, the radio takes ownership of it
+// The packet will be dropped if it has not made it to air within lifetime ticks
+uint8_t RadioEnqueue(RadioPacketT* packet, const enum RADIO_PRIORITY priority, const TickType_t lifetime)
+{
+	RadioPacketT* dropped;
+	TickType_t now = xTaskGetTickCount();
+
+	packet->Priority = priority;
+	packet->Expiration = now + lifetime;
+
+	taskENTER_CRITICAL();
+	dropped = TxSlotInsert(packet, now);
+	taskEXIT_CRITICAL();
+
+	PacketPoolFree(dropped);
+
+	// Wake the radio
+	if (radioTaskHandle != NULL)
+	{
+		xTaskNotifyGive(radioTaskHandle);
+	}
+
+	return (dropped != packet);
+}
+
+// Enqueue a pool packet for transmission from an interrupt
+uint8_t RadioEnqueueFromISR(RadioPacketT* packet, const enum RADIO_PRIORITY priority, const TickType_t lifetime)
+{
+	RadioPacketT* dropped;
+	UBaseType_t interruptStatus;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	TickType_t now = xTaskGetTickCountFromISR();
+
+	packet->Priority = priority;
+	packet->Expiration = now + lifetime;
+
+	interruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	dropped = TxSlotInsert(packet, now);
+	taskEXIT_CRITICAL_FROM_ISR(interruptStatus);
+
+	PacketPoolFree(dropped);
+
+	// Wake the radio
+	if (radioTaskHandle != NULL)
+	{
+		vTaskNotifyGiveFromISR(radioTaskHandle, &xHigherPriorityTaskWoken);
+		portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+	}
+
+	return (dropped != packet);
+}
+
+QueueHandle_t* RadioGetRxQueue(void)
+{
+	return rxQueue;
+}
+
+void RadioTaskStart(void)
+{
+	// Create task
+	xTaskCreate(RadioTask,
+		"Radio",
+		300,
+		NULL,
+		7,
+		&radioTaskHandle);
+}
+
+// Release the module from power down and queue up everything it needs
+// The command engine works through it while we encode, RadioPowerReady() then collects the result
+static void RadioPowerOn(void)
+{
+	// Retunes only ever happen here, between transmissions
+	float frequency = RegionGetFrequency();
+
+	// The command engine needs USART2 clocked until the radio goes back to sleep
+	LowPowerLock(LOW_POWER_LOCK_RADIO);
+
+	Dra818IoSetLowRfPower();
+	Dra818IoPowerUp();
+
+	radioChecked = 0;
+	groupPending.Valid = 0;
+	filterPending.Valid = 0;
+
+	// Connect retries until the module has booted
+	Dra818Connect();
+
+	// Configure group
+	if (!groupApplied.Valid
+		|| groupApplied.Frequency != frequency
+		|| groupApplied.Squelch != RADIO_SQUELCH)
+	{
+		groupPending.Frequency = frequency;
+		groupPending.Squelch = RADIO_SQUELCH;
+		groupPending.Valid = Dra818SetGroup(groupPending.Frequency, groupPending.Frequency, "0000", "0000", groupPending.Squelch);
+	}
+
+	// Configure filter
+	if (!filterApplied.Valid
+		|| filterApplied.Predeemphasis != 1
+		|| filterApplied.Highpass != 0
+		|| filterApplied.Lowpass != 0)
+	{
+		filterPending.Predeemphasis = 1;
+		filterPending.Highpass = 0;
+		filterPending.Lowpass = 0;
+		filterPending.Valid = Dra818SetFilter(filterPending.Predeemphasis, filterPending.Highpass, filterPending.Lowpass);
+	}
+}
+
+// Wait for the module to finish waking up
+// Returns 1 if it acknowledged everything queued by RadioPowerOn()
+static uint8_t RadioPowerReady(void)
+{
+	// Already checked since the last power up
+	if (radioChecked)
+	{
+		return radioOk;
+	}
+
+	radioChecked = 1;
+	radioOk = Dra818Wait(RADIO_READY_TIMEOUT / portTICK_PERIOD_MS);
+
+	if (radioOk)
+	{
+		// The module has what we sent it
+		if (groupPending.Valid)
+		{
+			groupApplied = groupPending;
+		}
+
+		if (filterPending.Valid)
+		{
+			filterApplied = filterPending;
+		}
+	}
+	else
+	{
+		// We don't know what it has anymore, send everything next time
+		groupApplied.Valid = 0;
+		filterApplied.Valid = 0;
+	}
+
+	return radioOk;
+}
+
+static void RadioPowerOff(void)
+{
+	// Let anything still in flight run out before pulling the power
+	Dra818Wait(RADIO_READY_TIMEOUT / portTICK_PERIOD_MS);
+
+	Dra818IoPttOff();
+	Dra818IoPowerDown();
+
+	LowPowerUnlock(LOW_POWER_LOCK_RADIO);
+}
+
+// Radio manager task
+void RadioTask(void* pvParameters)
+{
+	uint32_t encodedAudioLength;
+	uint32_t ax25Len;
+	RadioPacketT* packetOut;
+	TickType_t encodeStart;
+	TickType_t airTime;
+	int32_t liveAge;
+
+	// Configure the radio once up front so a dead module shows up at boot, then let it sleep
+	RadioPowerOn();
+	if (!RadioPowerReady())
+	{
+		printf("Warning: DRA818 not responding\r\n");
+	}
+	RadioPowerOff();
+
+	// Airtime / radio management loop
+	while (1)
+	{
+		// Sleep until someone queues a packet
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+		// No flash stalls from here until the radio is back asleep
+		FlashJobHold(FLASH_JOB_HOLD_RADIO);
+
+		// Encoding and audio timing need the full clock
+		ClockRequestFull(CLOCK_USER_MODEM);
+
+		// Start waking the radio, it boots while the first packet encodes
+		// DAC, DMA and USART2 need their clocks until it goes back to sleep
+		RadioPowerOn();
+
+		// Send everything that is still fresh, most valuable first
+		while ((packetOut = TxSlotTakeNext(xTaskGetTickCount())) != NULL)
+		{
+			// Make sure the radio is up before going any further, from here to air time has to be predictable
+			// If it doesn't answer, key it anyway, it still has whatever it was last configured with
+			if (!RadioPowerReady())
+			{
+				printf("Warning: DRA818 not responding\r\n");
+			}
+
+			// We have something to transmit, build and encode the packet
+			packetOut->Frame.Path = packetOut->Path;
+			packetOut->Frame.Payload = packetOut->Payload;
+			encodeStart = xTaskGetTickCount();
+
+			// Bring a position forward to when its coordinates will actually be on air
+			if (packetOut->LivePosition)
+			{
+				airTime = encodeStart + encodeTime
+					+ (PTT_DOWN_DELAY + AIR_TIME(Ax25PayloadOffset(&packetOut->Frame) + APRS_COORDINATE_OFFSET)) / portTICK_PERIOD_MS;
+				liveAge = (int32_t)(airTime - packetOut->LiveFixTime) * portTICK_PERIOD_MS;
+
+				// Held up in the queue too long, the velocities no longer say where it is, leave it as of the fix
+				if (liveAge >= 0 && liveAge <= APRS_MAX_EXTRAPOLATION)
+				{
+					AprsRefreshPosition(packetOut->Payload, &packetOut->Live, liveAge);
+				}
+			}
+
+			printf("[TX] %.*s\r\n", (int)packetOut->Frame.PayloadLength, packetOut->Payload);
+
+			ax25Len = Ax25BuildUnPacket(&packetOut->Frame, ax25Buffer);
+
+			// Audio encoding
+			encodedAudioLength = AfskHdlcEncode(ax25Buffer,
+				ax25Len,
+				packetOut->Frame.PreFlagCount,
+				ax25Len - packetOut->Frame.PostFlagCount,
+				audioOut,
+				AUDIO_BUFFER_SIZE
+			);
+
+			CrashTrace(CRASH_TRACE_TX_START, packetOut->Priority);
+
+			// Everything we need is in the audio buffer now, so the packet can go back to the pool
+			PacketPoolFree(packetOut);
+
+			// If the encoded audio length is zero, the encode output buffer wasn't big enough to accomidate the entire payload
+			// It might be mission critical that this gets out in a worst case scenario
+			// So just transmit the entire buffer...
+			if (!encodedAudioLength)
+			{
+				encodedAudioLength = AUDIO_BUFFER_SIZE;
+			}
+
+			// Start xmit
+			encodeTime = xTaskGetTickCount() - encodeStart;
+			LedOn(LED_2);
+			Dra818IoPttOn();
+			Dra818IoSetHighRfPower();
+			
+			// Wait to play until after we PTT down
+			vTaskDelay(PTT_DOWN_DELAY / portTICK_PERIOD_MS);
+
+			// Play audio
+			AudioPlay(audioOut, encodedAudioLength);
+
+			// Block while we're transmitting
+			AudioOutWait(portMAX_DELAY);
+
+			// Wait a little longer before we PTT up
+			vTaskDelay(PTT_UP_DELAY / portTICK_PERIOD_MS);
+
+			// Stop Xmit
+			Dra818IoPttOff();
+			Dra818IoSetLowRfPower();
+			LedOff(LED_2);
+
+			CrashTrace(CRASH_TRACE_TX_END, 0);
+		}
+
+		// Nothing left to send, the radio can sleep until the next packet
+		RadioPowerOff();
+
+		// Back down to the low clock until there is more to send
+		ClockReleaseFull(CLOCK_USER_MODEM);
+
+		// Anything waiting to go to flash can have its turn
+		FlashJobRelease(FLASH_JOB_HOLD_RADIO);
+	}
 }
\ No newline at end of file
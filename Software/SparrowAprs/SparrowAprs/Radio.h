@@ -1,22 +1,38 @@
-#ifndef RADIO_H
-#define RADIO_H
-#include "FreeRTOS.h"
-#include <stdint.h>
-#include "task.h"
-#include "queue.h"
-#include "Ax25.h"
-
-typedef struct
-{
-	Ax25FrameT Frame;
-	uint8_t Path[56];
-	uint8_t Payload[200];
-	TickType_t Expiration;
-} RadioPacketT;
-
-void RadioInit(void);
-void RadioTaskStart(void);
-QueueHandle_t* RadioGetTxQueue(void);
-QueueHandle_t* RadioGetRxQueue(void);
-
-#endif // !RADIO_H
+#ifndef RADIO_H
+#define RADIO_H
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include "task.h"
+#include "queue.h"
+#include "Ax25.h"
+#include "Aprs.h"
+
+// Transmit priorities, higher values are sent first
+enum RADIO_PRIORITY
+{
+	RADIO_PRIORITY_STATUS,
+	RADIO_PRIORITY_TELEMETRY,
+	RADIO_PRIORITY_POSITION,
+	RADIO_PRIORITY_DESCENT_POSITION,
+	RADIO_PRIORITY_MESSAGE
+};
+
+typedef struct
+{
+	Ax25FrameT Frame;
+	uint8_t Path[56];
+	uint8_t Payload[200];
+	TickType_t Expiration;
+	enum RADIO_PRIORITY Priority;
+	uint8_t LivePosition;
+	TickType_t LiveFixTime;
+	AprsLivePositionT Live;
+} RadioPacketT;
+
+void RadioInit(void);
+void RadioTaskStart(void);
+uint8_t RadioEnqueue(RadioPacketT* packet, const enum RADIO_PRIORITY priority, const TickType_t lifetime);
+uint8_t RadioEnqueueFromISR(RadioPacketT* packet, const enum RADIO_PRIORITY priority, const TickType_t lifetime);
+QueueHandle_t* RadioGetRxQueue(void);
+
+#endif // !RADIO_H
@@ -0,0 +1,635 @@
+/*
+	Flight recorder
+
+	Everything we know about the flight, every fix, into the spare flash
+	sectors 6-9. Between received packets this is the only record there is.
+
+	Sectors are used as a ring, the oldest is erased when we run out. Each
+	starts with a header holding its sequence number and an index of when each
+	of its 2KB blocks was started, so a time range is found from 256 index
+	words without decoding anything.
+
+		RecorderSectorHeaderT		magic, sequence, block start times
+		block 0						records
+		block 1..63					records
+
+	Every block starts with a keyframe carrying the RTC time and every field in
+	full, so any block can be decoded on its own. After that each record is a
+	field mask and zigzag varints of how far each field is from a prediction.
+	Fields that move steadily (time, position, altitude, pressure) are
+	predicted from their last two values, the rest from their last value, and
+	fields that hit the prediction aren't stored at all. A fix in steady
+	flight comes to 6-10 bytes.
+
+	A record starts with its tag, 0x01 or 0x02, and ends on the last byte of a
+	varint, which is below 0x80. Neither is ever 0xFF, so a block's records end
+	where its erased bytes start, reading forwards from a tag or backwards from
+	the end.
+
+	The sectors are only ours while the firmware image ends below them, which
+	is checked at init against where the linker put the end of the image.
+*/
+
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+#include "GpsHub.h"
+#include "Altimeter.h"
+#include "Bsp.h"
+#include "Rtc.h"
+#include "CrcCcitt.h"
+#include "Usb.h"
+#include "FlashJob.h"
+#include "Recorder.h"
+
+// Sectors 6-9, 128KB each
+#define RECORDER_BASE			0x08040000
+#define RECORDER_SECTOR_SIZE	0x20000
+#define RECORDER_SECTOR_COUNT	4
+static const uint32_t recorderSectors[RECORDER_SECTOR_COUNT] = { FLASH_SECTOR_6, FLASH_SECTOR_7, FLASH_SECTOR_8, FLASH_SECTOR_9 };
+
+#define BLOCK_SIZE				2048
+#define BLOCK_COUNT				(RECORDER_SECTOR_SIZE / BLOCK_SIZE)
+
+#define RECORDER_MAGIC			0xF1173D47
+#define ERASED_WORD				0xFFFFFFFF
+
+typedef struct
+{
+	uint32_t Magic;
+	uint32_t Sequence;
+	uint32_t BlockTime[BLOCK_COUNT];
+} RecorderSectorHeaderT;
+
+// Record tags
+#define RECORD_DELTA			0x01
+#define RECORD_KEY				0x02
+
+// Worst case record, tag, RTC time and every field as a 5 byte varint
+#define MAX_RECORD_SIZE			(1 + 4 + 3 + FIELD_COUNT * 5)
+
+// Log the sensors at least this often when there's no fix coming in
+#define SENSOR_PERIOD			10000
+
+// Only ever block this long waiting for a fix, so download requests get seen
+#define WAIT_PERIOD				1000
+
+// A fix this old is not news
+#define MAX_FIX_AGE				2000
+
+// Erases are tried this often before a sector is passed over
+#define ERASE_ATTEMPTS			2
+
+// Fields, in the order and units they're stored
+enum RECORDER_FIELD
+{
+	FIELD_TICK,					// ms since boot
+	FIELD_LAT,					// 1e-7 degrees
+	FIELD_LON,					// 1e-7 degrees
+	FIELD_ALTITUDE,				// GPS, dm
+	FIELD_SPEED,				// 0.1 knots
+	FIELD_TRACK,				// degrees
+	FIELD_FUSED_ALTITUDE,		// dm
+	FIELD_VERTICAL_SPEED,		// dm/s
+	FIELD_PRESSURE,				// Pa
+	FIELD_TEMPERATURE,			// 0.1 C
+	FIELD_HUMIDITY,				// %
+	FIELD_VSENSE,				// 10mV
+	FIELD_CPU_TEMPERATURE,		// C
+	FIELD_FLAGS,
+	FIELD_COUNT
+};
+
+// Fields that move steadily enough to predict from the last two values
+#define SECOND_ORDER_FIELDS		((1 << FIELD_TICK) | (1 << FIELD_LAT) | (1 << FIELD_LON) \
+	| (1 << FIELD_ALTITUDE) | (1 << FIELD_FUSED_ALTITUDE) | (1 << FIELD_PRESSURE))
+
+// Flags field
+#define FLAG_FIX				(1 << 0)
+#define FLAG_ALTITUDE			(1 << 1)
+#define FLAG_VELOCITY			(1 << 2)
+#define FLAG_ALTIMETER			(1 << 3)
+#define FLAG_BURST				(1 << 4)
+
+// Download frames, '$' 'R' sequence block length data crc
+#define DOWNLOAD_HEADER			'$'
+#define DOWNLOAD_IDENT			'R'
+#define DOWNLOAD_FRAME_HEADER	9
+
+// From the linker script, the initial values of .data are the last thing in the image
+extern uint32_t _sidata;
+extern uint32_t _sdata;
+extern uint32_t _edata;
+
+// Off if the image has grown into our sectors
+static uint8_t enabled = 0;
+
+// Where we're writing
+static uint32_t sectorIndex;
+static uint32_t sequence;
+static uint32_t block;
+static uint32_t offset;
+static uint8_t blockOpen = 0;
+
+// Last two values of each field, for the predictions
+static int32_t previous[FIELD_COUNT];
+static int32_t previous2[FIELD_COUNT];
+
+static uint8_t record[MAX_RECORD_SIZE];
+
+static volatile uint8_t downloadRequested = 0;
+static volatile uint32_t downloadStart;
+static volatile uint32_t downloadEnd;
+
+static void RecorderTask(void* pvParameters);
+static TaskHandle_t recorderTaskHandle = NULL;
+
+void RecorderInit(void)
+{
+	uint32_t imageEnd = (uint32_t)&_sidata + ((uint32_t)&_edata - (uint32_t)&_sdata);
+
+	memset(previous, 0, sizeof(previous));
+	memset(previous2, 0, sizeof(previous2));
+
+	// Erasing these would take the firmware with them
+	if (imageEnd > RECORDER_BASE)
+	{
+		printf("Warning: image ends at %08lx, recorder disabled\r\n", imageEnd);
+		return;
+	}
+
+	enabled = 1;
+}
+
+void RecorderStartTask(void)
+{
+	if (!enabled)
+	{
+		return;
+	}
+
+	// Create task
+	// Lowest priority there is, flash can wait for everyone else
+	xTaskCreate(RecorderTask,
+		"Recorder",
+		300,
+		NULL,
+		1,
+		&recorderTaskHandle);
+
+	// Woken by the hub on new fixes
+	GpsHubSubscribe(recorderTaskHandle);
+}
+
+// Ask for records between two RTC times to be sent over USB
+// Safe to call from the USB ISR
+void RecorderRequestDownload(const uint32_t start, const uint32_t end)
+{
+	downloadStart = start;
+	downloadEnd = end;
+	downloadRequested = 1;
+}
+
+static RecorderSectorHeaderT* SectorHeader(const uint32_t index)
+{
+	return (RecorderSectorHeaderT*)(RECORDER_BASE + index * RECORDER_SECTOR_SIZE);
+}
+
+static uint8_t* BlockAddress(const uint32_t index, const uint32_t b)
+{
+	return (uint8_t*)SectorHeader(index) + b * BLOCK_SIZE;
+}
+
+// Where records start in a block, block 0 shares with the header
+static uint32_t BlockDataStart(const uint32_t b)
+{
+	return (b == 0) ? sizeof(RecorderSectorHeaderT) : 0;
+}
+
+static uint8_t SectorIsValid(const uint32_t index)
+{
+	return SectorHeader(index)->Magic == RECORDER_MAGIC;
+}
+
+// Sequence numbers wrap, newer is whichever is ahead by less than half the range
+static uint8_t SequenceIsNewer(const uint32_t a, const uint32_t b)
+{
+	return (int32_t)(a - b) > 0;
+}
+
+static uint8_t ProgramWord(uint32_t* address, const uint32_t data)
+{
+	return FlashJobProgram(address, &data, sizeof(data));
+}
+
+// Pick up after the newest block on the newest sector
+// Whatever was left of that block is abandoned, a fresh keyframe is cheaper than finding the end
+static void Open(void)
+{
+	uint8_t found = 0;
+	uint32_t i;
+	RecorderSectorHeaderT* header;
+
+	for (i = 0; i < RECORDER_SECTOR_COUNT; i++)
+	{
+		if (SectorIsValid(i) && (!found || SequenceIsNewer(SectorHeader(i)->Sequence, sequence)))
+		{
+			found = 1;
+			sectorIndex = i;
+			sequence = SectorHeader(i)->Sequence;
+		}
+	}
+
+	if (!found)
+	{
+		// Start on sector 0 as the first write rolls over
+		sectorIndex = RECORDER_SECTOR_COUNT - 1;
+		sequence = 0;
+		block = BLOCK_COUNT;
+		return;
+	}
+
+	header = SectorHeader(sectorIndex);
+	block = 0;
+
+	while (block < BLOCK_COUNT && header->BlockTime[block] != ERASED_WORD)
+	{
+		block++;
+	}
+}
+
+// Move on to the oldest sector and wipe it
+// A sector that won't erase or take its header is passed over, the next attempt tries the one after
+static uint8_t NextSector(void)
+{
+	RecorderSectorHeaderT* header;
+	uint32_t attempt;
+	uint8_t erased = 0;
+
+	sectorIndex = (sectorIndex + 1) % RECORDER_SECTOR_COUNT;
+	sequence++;
+	block = BLOCK_COUNT;
+	header = SectorHeader(sectorIndex);
+
+	for (attempt = 0; attempt < ERASE_ATTEMPTS && !erased; attempt++)
+	{
+		erased = FlashJobErase(recorderSectors[sectorIndex]);
+	}
+
+	// Magic last, a sector we lose power in the middle of setting up is just ignored
+	if (!erased
+		|| !ProgramWord(&header->Sequence, sequence)
+		|| !ProgramWord(&header->Magic, RECORDER_MAGIC))
+	{
+		return 0;
+	}
+
+	block = 0;
+
+	return 1;
+}
+
+static uint32_t PutVarint(uint8_t* buffer, uint32_t value)
+{
+	uint32_t length = 0;
+
+	while (value >= 0x80)
+	{
+		buffer[length++] = (value & 0x7f) | 0x80;
+		value >>= 7;
+	}
+
+	buffer[length++] = value;
+
+	return length;
+}
+
+static uint32_t PutSigned(uint8_t* buffer, const int32_t value)
+{
+	// Zigzag, small magnitudes of either sign stay small
+	return PutVarint(buffer, ((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+static int32_t Predict(const uint32_t field)
+{
+	if (SECOND_ORDER_FIELDS & (1 << field))
+	{
+		return 2 * previous[field] - previous2[field];
+	}
+
+	return previous[field];
+}
+
+static void Remember(const int32_t* sample)
+{
+	memcpy(previous2, previous, sizeof(previous));
+	memcpy(previous, sample, sizeof(previous));
+}
+
+static uint32_t EncodeKey(const int32_t* sample, const uint32_t time)
+{
+	uint32_t length = 0;
+	uint32_t i;
+
+	record[length++] = RECORD_KEY;
+	record[length++] = time & 0xff;
+	record[length++] = (time >> 8) & 0xff;
+	record[length++] = (time >> 16) & 0xff;
+	record[length++] = (time >> 24) & 0xff;
+
+	for (i = 0; i < FIELD_COUNT; i++)
+	{
+		length += PutSigned(record + length, sample[i]);
+	}
+
+	// Predictions restart from here, a block decodes on its own
+	memcpy(previous2, sample, sizeof(previous2));
+	memcpy(previous, sample, sizeof(previous));
+
+	return length;
+}
+
+static uint32_t EncodeDelta(const int32_t* sample)
+{
+	int32_t residual[FIELD_COUNT];
+	uint32_t mask = 0;
+	uint32_t length = 0;
+	uint32_t i;
+
+	for (i = 0; i < FIELD_COUNT; i++)
+	{
+		residual[i] = sample[i] - Predict(i);
+
+		if (residual[i] != 0)
+		{
+			mask |= 1 << i;
+		}
+	}
+
+	record[length++] = RECORD_DELTA;
+	length += PutVarint(record + length, mask);
+
+	for (i = 0; i < FIELD_COUNT; i++)
+	{
+		if (mask & (1 << i))
+		{
+			length += PutSigned(record + length, residual[i]);
+		}
+	}
+
+	Remember(sample);
+
+	return length;
+}
+
+// Start the next block with a keyframe
+static uint8_t StartBlock(const int32_t* sample)
+{
+	uint32_t time = RtcGet();
+	uint32_t length;
+
+	if (block >= BLOCK_COUNT && !NextSector())
+	{
+		return 0;
+	}
+
+	// Indexed before anything goes in, so download can find it
+	if (!ProgramWord(&SectorHeader(sectorIndex)->BlockTime[block], time))
+	{
+		block++;
+		return 0;
+	}
+
+	offset = BlockDataStart(block);
+	length = EncodeKey(sample, time);
+	blockOpen = FlashJobProgram(BlockAddress(sectorIndex, block) + offset, record, length);
+	offset += length;
+
+	// Its index word is written, so the block is spent even if the keyframe didn't go in
+	if (!blockOpen)
+	{
+		block++;
+	}
+
+	return blockOpen;
+}
+
+static void Append(const int32_t* sample)
+{
+	uint32_t length;
+
+	if (blockOpen)
+	{
+		length = EncodeDelta(sample);
+
+		if (offset + length <= BLOCK_SIZE)
+		{
+			blockOpen = FlashJobProgram(BlockAddress(sectorIndex, block) + offset, record, length);
+			offset += length;
+
+			// Nothing more goes on top of a failed program, the next sample starts a new block
+			if (!blockOpen)
+			{
+				block++;
+			}
+
+			return;
+		}
+
+		// Doesn't fit, the rest of this block stays erased
+		block++;
+		blockOpen = 0;
+	}
+
+	StartBlock(sample);
+}
+
+// Everything we're logging, in the units it's stored in
+// Anything not measured this time is left at its prediction, so it costs nothing
+static void BuildSample(int32_t* sample, const SituationInfoT* situation, const uint8_t newFix)
+{
+	AltimeterStateT altimeter;
+	uint32_t flags = 0;
+	uint32_t i;
+
+	for (i = 0; i < FIELD_COUNT; i++)
+	{
+		sample[i] = Predict(i);
+	}
+
+	AltimeterGetState(&altimeter);
+
+	sample[FIELD_TICK] = (int32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+
+	if (newFix)
+	{
+		flags |= FLAG_FIX;
+		sample[FIELD_LAT] = situation->Lat;
+		sample[FIELD_LON] = situation->Lon;
+
+		if (situation->AltitudeValid)
+		{
+			flags |= FLAG_ALTITUDE;
+			sample[FIELD_ALTITUDE] = (int32_t)(situation->Altitude * 10.0f);
+		}
+
+		if (situation->VelocityValid)
+		{
+			flags |= FLAG_VELOCITY;
+			sample[FIELD_SPEED] = (int32_t)(situation->Speed * 10.0f);
+			sample[FIELD_TRACK] = (int32_t)situation->Track;
+		}
+	}
+
+	if (altimeter.Valid)
+	{
+		flags |= FLAG_ALTIMETER;
+		sample[FIELD_FUSED_ALTITUDE] = (int32_t)(altimeter.Altitude * 10.0f);
+		sample[FIELD_VERTICAL_SPEED] = (int32_t)(altimeter.VerticalSpeed * 10.0f);
+	}
+
+	if (altimeter.BaroValid)
+	{
+		sample[FIELD_PRESSURE] = (int32_t)altimeter.Pressure;
+		sample[FIELD_TEMPERATURE] = (int32_t)(altimeter.Temperature * 10.0f);
+		sample[FIELD_HUMIDITY] = (int32_t)altimeter.Humidity;
+	}
+
+	if (altimeter.Burst)
+	{
+		flags |= FLAG_BURST;
+	}
+
+	sample[FIELD_VSENSE] = (int32_t)(BspGetVSense() * 100.0f);
+	sample[FIELD_CPU_TEMPERATURE] = (int32_t)BspGetuCTemperature();
+	sample[FIELD_FLAGS] = flags;
+}
+
+static uint8_t SendBlock(const uint32_t index, const uint32_t b)
+{
+	const uint8_t* data = BlockAddress(index, b) + BlockDataStart(b);
+	uint32_t length = BLOCK_SIZE - BlockDataStart(b);
+	uint8_t frame[DOWNLOAD_FRAME_HEADER];
+	uint16_t crc;
+	uint32_t s = SectorHeader(index)->Sequence;
+
+	// Trailing erased bytes aren't records
+	while (length > 0 && data[length - 1] == 0xff)
+	{
+		length--;
+	}
+
+	frame[0] = DOWNLOAD_HEADER;
+	frame[1] = DOWNLOAD_IDENT;
+	frame[2] = s & 0xff;
+	frame[3] = (s >> 8) & 0xff;
+	frame[4] = (s >> 16) & 0xff;
+	frame[5] = (s >> 24) & 0xff;
+	frame[6] = b;
+	frame[7] = length & 0xff;
+	frame[8] = (length >> 8) & 0xff;
+	crc = CrcCcitt(data, length);
+
+	return UsbTransmit(frame, sizeof(frame))
+		&& UsbTransmit(data, length)
+		&& UsbTransmit((uint8_t*)&crc, sizeof(crc));
+}
+
+// Send every block that overlaps the requested range, oldest first, then an empty frame
+// The block index is all we look at to find them
+static void Download(const uint32_t start, const uint32_t end)
+{
+	uint8_t sent[RECORDER_SECTOR_COUNT];
+	uint8_t frame[DOWNLOAD_FRAME_HEADER + 2];
+	RecorderSectorHeaderT* header;
+	uint32_t oldest;
+	uint32_t blockEnd;
+	uint32_t i;
+	uint32_t b;
+	uint32_t n;
+
+	memset(sent, 0, sizeof(sent));
+
+	for (n = 0; n < RECORDER_SECTOR_COUNT; n++)
+	{
+		oldest = RECORDER_SECTOR_COUNT;
+
+		for (i = 0; i < RECORDER_SECTOR_COUNT; i++)
+		{
+			if (!sent[i] && SectorIsValid(i)
+				&& (oldest == RECORDER_SECTOR_COUNT || SequenceIsNewer(SectorHeader(oldest)->Sequence, SectorHeader(i)->Sequence)))
+			{
+				oldest = i;
+			}
+		}
+
+		if (oldest == RECORDER_SECTOR_COUNT)
+		{
+			break;
+		}
+
+		sent[oldest] = 1;
+		header = SectorHeader(oldest);
+
+		for (b = 0; b < BLOCK_COUNT && header->BlockTime[b] != ERASED_WORD; b++)
+		{
+			// A block runs until the next one starts
+			blockEnd = (b + 1 < BLOCK_COUNT && header->BlockTime[b + 1] != ERASED_WORD) ? header->BlockTime[b + 1] : ERASED_WORD;
+
+			if (header->BlockTime[b] > end || blockEnd < start)
+			{
+				continue;
+			}
+
+			if (!SendBlock(oldest, b))
+			{
+				return;
+			}
+		}
+	}
+
+	memset(frame, 0, sizeof(frame));
+	frame[0] = DOWNLOAD_HEADER;
+	frame[1] = DOWNLOAD_IDENT;
+	UsbTransmit(frame, sizeof(frame));
+}
+
+static void RecorderTask(void* pvParameters)
+{
+	SituationInfoT situation;
+	int32_t sample[FIELD_COUNT];
+	uint32_t lastSequence = 0;
+	TickType_t lastRecord = 0;
+	TickType_t timeNow;
+	uint8_t newFix;
+
+	Open();
+
+	situation.Sequence = 0;
+
+	while (1)
+	{
+		GpsHubWaitSituation(&situation, lastSequence, WAIT_PERIOD);
+		timeNow = xTaskGetTickCount();
+
+		// Every fix, or the sensors on their own now and then
+		newFix = situation.Sequence != lastSequence && situation.FixValid
+			&& timeNow - situation.Timestamp < MAX_FIX_AGE;
+		lastSequence = situation.Sequence;
+
+		if (newFix || timeNow - lastRecord >= SENSOR_PERIOD)
+		{
+			BuildSample(sample, &situation, newFix);
+			Append(sample);
+			lastRecord = timeNow;
+		}
+
+		if (downloadRequested)
+		{
+			downloadRequested = 0;
+			Download(downloadStart, downloadEnd);
+		}
+	}
+}
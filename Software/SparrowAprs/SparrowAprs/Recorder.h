@@ -0,0 +1,10 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <stdint.h>
+
+void RecorderInit(void);
+void RecorderStartTask(void);
+void RecorderRequestDownload(const uint32_t start, const uint32_t end);
+
+#endif // !RECORDER_H
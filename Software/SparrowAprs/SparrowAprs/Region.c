@@ -0,0 +1,247 @@
+/*
+	Regional APRS frequency selection
+
+	Each region is a simplified polygon in tenths of a degree. At boot the
+	bounding box of every region is dropped into a coarse 20 degree grid, so
+	a lookup only has to run point in polygon against the one or two regions
+	that can possibly cover the fix.
+
+	Anywhere that isn't covered falls back to the configured frequency.
+*/
+#include <stm32f4xx_hal.h>
+#include <stdio.h>
+#include "Config.h"
+#include "FlashConfig.h"
+#include "Region.h"
+
+typedef struct
+{
+	int16_t Lat;
+	int16_t Lon;
+} RegionPointT;
+
+typedef struct
+{
+	const char* Name;
+	float Frequency;
+	const RegionPointT* Points;
+	uint8_t PointCount;
+} RegionT;
+
+typedef struct
+{
+	int16_t MinLat;
+	int16_t MaxLat;
+	int16_t MinLon;
+	int16_t MaxLon;
+} RegionBoxT;
+
+// Outlines, in tenths of a degree
+// These are deliberately coarse, they only need to be right away from the borders
+static const RegionPointT northAmerica[] = {
+	{ 720, -1700 }, { 720, -500 }, { 450, -500 }, { 250, -750 }, { 150, -820 },
+	{ 140, -920 }, { 140, -1180 }, { 500, -1350 }, { 520, -1700 }
+};
+
+static const RegionPointT europeAfrica[] = {
+	{ -350, -200 }, { 380, -200 }, { 720, -300 }, { 780, 300 }, { 780, 1800 },
+	{ 620, 1800 }, { 480, 1350 }, { 530, 1200 }, { 500, 880 }, { 420, 800 },
+	{ 370, 700 }, { 250, 620 }, { 120, 550 }, { -350, 550 }
+};
+
+static const RegionPointT china[] = {
+	{ 490, 730 }, { 540, 1200 }, { 480, 1350 }, { 400, 1240 }, { 300, 1220 },
+	{ 220, 1170 }, { 180, 1080 }, { 210, 1000 }, { 280, 970 }, { 280, 850 },
+	{ 350, 780 }
+};
+
+static const RegionPointT japan[] = {
+	{ 300, 1280 }, { 360, 1280 }, { 460, 1400 }, { 460, 1460 }, { 400, 1460 },
+	{ 300, 1320 }
+};
+
+static const RegionPointT australia[] = {
+	{ -100, 1120 }, { -100, 1550 }, { -450, 1550 }, { -450, 1120 }
+};
+
+static const RegionPointT newZealand[] = {
+	{ -330, 1650 }, { -330, 1799 }, { -480, 1799 }, { -480, 1650 }
+};
+
+static const RegionPointT brazil[] = {
+	{ 50, -750 }, { 50, -500 }, { -50, -340 }, { -230, -400 }, { -340, -530 },
+	{ -300, -570 }, { -200, -580 }, { -100, -650 }, { -100, -730 }
+};
+
+static const RegionPointT argentina[] = {
+	{ -210, -680 }, { -220, -620 }, { -270, -560 }, { -340, -560 }, { -400, -620 },
+	{ -550, -650 }, { -550, -700 }, { -400, -716 }, { -330, -695 }, { -230, -670 }
+};
+
+#define REGION_ENTRY(name, frequency, points) { name, frequency, points, sizeof(points) / sizeof(RegionPointT) }
+
+// Checked in order, so smaller regions that sit inside a bigger one go first
+static const RegionT regions[] = {
+	REGION_ENTRY("JA", 144.640f, japan),
+	REGION_ENTRY("BY", 144.640f, china),
+	REGION_ENTRY("ZL", 144.575f, newZealand),
+	REGION_ENTRY("VK", 145.175f, australia),
+	REGION_ENTRY("PY", 145.570f, brazil),
+	REGION_ENTRY("LU", 144.930f, argentina),
+	REGION_ENTRY("NA", 144.390f, northAmerica),
+	REGION_ENTRY("R1", 144.800f, europeAfrica)
+};
+
+#define REGION_COUNT		(sizeof(regions) / sizeof(RegionT))
+#define REGION_NONE			-1
+
+// Coarse grid index, one bit per region that might cover the cell
+#define GRID_CELL			200
+#define GRID_LAT_CELLS		(1800 / GRID_CELL)
+#define GRID_LON_CELLS		(3600 / GRID_CELL)
+static uint16_t grid[GRID_LAT_CELLS][GRID_LON_CELLS];
+static RegionBoxT boxes[REGION_COUNT];
+
+// How far past the edge of a region we have to be before we give it up
+#define REGION_EDGE_MARGIN	5
+
+static volatile int32_t currentRegion = REGION_NONE;
+
+static uint32_t GridLatCell(int32_t lat)
+{
+	lat = (lat + 900) / GRID_CELL;
+	return (lat < 0) ? 0 : (lat >= GRID_LAT_CELLS) ? GRID_LAT_CELLS - 1 : lat;
+}
+
+static uint32_t GridLonCell(int32_t lon)
+{
+	lon = (lon + 1800) / GRID_CELL;
+	return (lon < 0) ? 0 : (lon >= GRID_LON_CELLS) ? GRID_LON_CELLS - 1 : lon;
+}
+
+void RegionInit(void)
+{
+	uint32_t r, i, latCell, lonCell;
+	RegionBoxT* box;
+
+	for (r = 0; r < REGION_COUNT; r++)
+	{
+		box = &boxes[r];
+		box->MinLat = box->MaxLat = regions[r].Points[0].Lat;
+		box->MinLon = box->MaxLon = regions[r].Points[0].Lon;
+
+		// Bounding box
+		for (i = 1; i < regions[r].PointCount; i++)
+		{
+			if (regions[r].Points[i].Lat < box->MinLat) box->MinLat = regions[r].Points[i].Lat;
+			if (regions[r].Points[i].Lat > box->MaxLat) box->MaxLat = regions[r].Points[i].Lat;
+			if (regions[r].Points[i].Lon < box->MinLon) box->MinLon = regions[r].Points[i].Lon;
+			if (regions[r].Points[i].Lon > box->MaxLon) box->MaxLon = regions[r].Points[i].Lon;
+		}
+
+		// Mark every cell the box touches
+		for (latCell = GridLatCell(box->MinLat); latCell <= GridLatCell(box->MaxLat); latCell++)
+		{
+			for (lonCell = GridLonCell(box->MinLon); lonCell <= GridLonCell(box->MaxLon); lonCell++)
+			{
+				grid[latCell][lonCell] |= (1 << r);
+			}
+		}
+	}
+}
+
+// Even-odd ray cast, all in integer tenths of a degree
+static uint8_t RegionContains(const uint32_t r, const int32_t lat, const int32_t lon)
+{
+	const RegionPointT* points = regions[r].Points;
+	uint32_t i, j;
+	int32_t dLat, lhs, rhs;
+	uint8_t inside = 0;
+
+	if (lat < boxes[r].MinLat || lat > boxes[r].MaxLat || lon < boxes[r].MinLon || lon > boxes[r].MaxLon)
+	{
+		return 0;
+	}
+
+	for (i = 0, j = regions[r].PointCount - 1; i < regions[r].PointCount; j = i++)
+	{
+		// Only edges that straddle our latitude
+		if ((points[i].Lat > lat) == (points[j].Lat > lat))
+		{
+			continue;
+		}
+
+		// Is the crossing east of us? Cross multiplied to stay out of division
+		dLat = points[j].Lat - points[i].Lat;
+		lhs = (lon - points[i].Lon) * dLat;
+		rhs = (points[j].Lon - points[i].Lon) * (lat - points[i].Lat);
+
+		if ((dLat > 0) ? (lhs < rhs) : (lhs > rhs))
+		{
+			inside = !inside;
+		}
+	}
+
+	return inside;
+}
+
+static int32_t RegionFind(const int32_t lat, const int32_t lon)
+{
+	uint32_t r;
+	uint16_t candidates = grid[GridLatCell(lat)][GridLonCell(lon)];
+
+	for (r = 0; candidates; r++, candidates >>= 1)
+	{
+		if ((candidates & 1) && RegionContains(r, lat, lon))
+		{
+			return r;
+		}
+	}
+
+	return REGION_NONE;
+}
+
+// Within REGION_EDGE_MARGIN of region r
+static uint8_t RegionNear(const uint32_t r, const int32_t lat, const int32_t lon)
+{
+	return RegionContains(r, lat, lon)
+		|| RegionContains(r, lat + REGION_EDGE_MARGIN, lon)
+		|| RegionContains(r, lat - REGION_EDGE_MARGIN, lon)
+		|| RegionContains(r, lat, lon + REGION_EDGE_MARGIN)
+		|| RegionContains(r, lat, lon - REGION_EDGE_MARGIN);
+}
+
+// Feed a new fix in 1e-7 degrees
+void RegionUpdate(const int32_t lat, const int32_t lon)
+{
+	int32_t latTenths = lat / 1000000;
+	int32_t lonTenths = lon / 1000000;
+	int32_t region;
+
+	// Hang on to the region we're in until we're well clear of it
+	if (currentRegion != REGION_NONE && RegionNear(currentRegion, latTenths, lonTenths))
+	{
+		return;
+	}
+
+	region = RegionFind(latTenths, lonTenths);
+
+	if (region != currentRegion)
+	{
+		currentRegion = region;
+		printf("Region: %s\r\n", (region == REGION_NONE) ? "default" : regions[region].Name);
+	}
+}
+
+// Frequency we should be transmitting on right now
+float RegionGetFrequency(void)
+{
+	int32_t region = currentRegion;
+
+	if (region == REGION_NONE)
+	{
+		return FlashConfigGetPtr()->System.Frequency;
+	}
+
+	return regions[region].Frequency;
+}
\ No newline at end of file
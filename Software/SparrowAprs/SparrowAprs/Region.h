@@ -0,0 +1,10 @@
+#ifndef REGION_H
+#define REGION_H
+
+#include <stdint.h>
+
+void RegionInit(void);
+void RegionUpdate(const int32_t lat, const int32_t lon);
+float RegionGetFrequency(void);
+
+#endif // !REGION_H
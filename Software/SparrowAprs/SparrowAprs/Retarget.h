@@ -1,6 +1,6 @@
-#ifndef RETARGET_H
-#define RETARGET_H
-
-void RetargetInit(void);
-
-#endif // !RETARGET_H
+#ifndef RETARGET_H
+#define RETARGET_H
+
+void RetargetInit(void);
+
+#endif // !RETARGET_H
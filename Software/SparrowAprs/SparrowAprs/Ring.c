@@ -0,0 +1,145 @@
+/*
+	Single producer, single consumer byte ring
+
+	One side only ever writes Head, the other only ever writes Tail, so
+	neither needs a lock or a critical section. The producer can be a task,
+	an interrupt, or a DMA stream with an interrupt publishing how far it's
+	got.
+
+	Head and Tail run freely and wrap at 2^32. The buffer is a power of two
+	in size, so the distance between them is the count even across the wrap,
+	and an index into the buffer is just a mask.
+
+	Data is handed over with acquire/release ordering. The producer's bytes
+	are in memory before the Head that covers them is, and the consumer is
+	done with bytes before the Tail that frees them is.
+
+	The span functions give the largest contiguous run at either end, so
+	the producer can fill in place and the consumer can parse in place. A
+	run stops at the end of the buffer, the rest is at the start.
+*/
+
+#include <stdint.h>
+#include <string.h>
+#include "Ring.h"
+
+// Size must be a power of two
+uint8_t RingInit(RingT* ring, uint8_t* buffer, const uint32_t size)
+{
+	if (size == 0 || (size & (size - 1)) != 0)
+	{
+		return 0;
+	}
+
+	ring->Buffer = buffer;
+	ring->Mask = size - 1;
+	ring->Head = 0;
+	ring->Tail = 0;
+
+	return 1;
+}
+
+// Bytes waiting for the consumer
+uint32_t RingCount(const RingT* ring)
+{
+	return __atomic_load_n(&ring->Head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->Tail, __ATOMIC_ACQUIRE);
+}
+
+// Bytes the producer can write
+uint32_t RingSpace(const RingT* ring)
+{
+	return ring->Mask + 1 - RingCount(ring);
+}
+
+// Where the producer can write next, and how much of it is contiguous
+uint8_t* RingWriteSpan(const RingT* ring, uint32_t* length)
+{
+	uint32_t head = ring->Head;
+	uint32_t space = ring->Mask + 1 - (head - __atomic_load_n(&ring->Tail, __ATOMIC_ACQUIRE));
+	uint32_t end = ring->Mask + 1 - (head & ring->Mask);
+
+	*length = space < end ? space : end;
+
+	return ring->Buffer + (head & ring->Mask);
+}
+
+// Hand length bytes written at the head over to the consumer
+void RingCommit(RingT* ring, const uint32_t length)
+{
+	__atomic_store_n(&ring->Head, ring->Head + length, __ATOMIC_RELEASE);
+}
+
+// All of it or none of it, returns 0 if there isn't room
+uint8_t RingWrite(RingT* ring, const uint8_t* data, const uint32_t length)
+{
+	uint8_t* span;
+	uint32_t spanLength;
+	uint32_t first;
+
+	if (RingSpace(ring) < length)
+	{
+		return 0;
+	}
+
+	span = RingWriteSpan(ring, &spanLength);
+	first = length < spanLength ? length : spanLength;
+
+	memcpy(span, data, first);
+	memcpy(ring->Buffer, data + first, length - first);
+
+	RingCommit(ring, length);
+
+	return 1;
+}
+
+// What the consumer can read from offset bytes past the tail, and how much of it is contiguous
+// Returns NULL when there's nothing there yet
+const uint8_t* RingReadSpan(const RingT* ring, const uint32_t offset, uint32_t* length)
+{
+	uint32_t tail = ring->Tail;
+	uint32_t count = __atomic_load_n(&ring->Head, __ATOMIC_ACQUIRE) - tail;
+	uint32_t index = (tail + offset) & ring->Mask;
+	uint32_t end = ring->Mask + 1 - index;
+
+	if (offset >= count)
+	{
+		*length = 0;
+		return NULL;
+	}
+
+	*length = count - offset < end ? count - offset : end;
+
+	return ring->Buffer + index;
+}
+
+// The caller has checked the count
+uint8_t RingPeek(const RingT* ring, const uint32_t offset)
+{
+	return ring->Buffer[(ring->Tail + offset) & ring->Mask];
+}
+
+// Copy out from offset bytes past the tail, across the wrap if need be
+// Returns 0 if that much hasn't arrived yet
+uint8_t RingCopy(const RingT* ring, const uint32_t offset, uint8_t* data, const uint32_t length)
+{
+	uint32_t index = (ring->Tail + offset) & ring->Mask;
+	uint32_t first = ring->Mask + 1 - index;
+
+	if (RingCount(ring) < offset + length)
+	{
+		return 0;
+	}
+
+	first = length < first ? length : first;
+
+	memcpy(data, ring->Buffer + index, first);
+	memcpy(data + first, ring->Buffer, length - first);
+
+	return 1;
+}
+
+// Give length bytes at the tail back to the producer
+void RingConsume(RingT* ring, const uint32_t length)
+{
+	__atomic_store_n(&ring->Tail, ring->Tail + length, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,27 @@
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+
+typedef struct
+{
+	uint8_t* Buffer;
+	uint32_t Mask;
+	volatile uint32_t Head;
+	volatile uint32_t Tail;
+} RingT;
+
+uint8_t RingInit(RingT* ring, uint8_t* buffer, const uint32_t size);
+uint32_t RingCount(const RingT* ring);
+uint32_t RingSpace(const RingT* ring);
+
+uint8_t* RingWriteSpan(const RingT* ring, uint32_t* length);
+void RingCommit(RingT* ring, const uint32_t length);
+uint8_t RingWrite(RingT* ring, const uint8_t* data, const uint32_t length);
+
+const uint8_t* RingReadSpan(const RingT* ring, const uint32_t offset, uint32_t* length);
+uint8_t RingPeek(const RingT* ring, const uint32_t offset);
+uint8_t RingCopy(const RingT* ring, const uint32_t offset, uint8_t* data, const uint32_t length);
+void RingConsume(RingT* ring, const uint32_t length);
+
+#endif // !RING_H
@@ -1,99 +1,341 @@
-#include <stm32f4xx_hal.h>
-#include <math.h>
-#include <string.h>
-#include <time.h>
-
-// Stolen from:
-// https://community.st.com/thread/46986-unix-epoch-timestamp-to-rtc?commentID=183088
-
-#define RTC_TIME_GOOD_WORD		0x32F2
-
-// Peripheral handles
-static RTC_HandleTypeDef hrtc;
-
-// 1 Mhz clock provided by HSE_DIV25
-#define RTC_PREDIV_A	125
-#define RTC_PREDIV_S	8000
-
-// Unix epoch information
-// STM32 cares about 
-#define MONTH_EPOCH	1
-#define YEAR_EPOCH	(2000 - 1900)
-
-void RtcInit(void)
-{
-	// Enable clocks
-	__HAL_RCC_RTC_ENABLE();
-
-	// Configure RTC
-	hrtc.Instance = RTC;
-	hrtc.Init.HourFormat = RTC_HOURFORMAT_24;
-	hrtc.Init.AsynchPrediv = RTC_PREDIV_A - 1;
-	hrtc.Init.SynchPrediv = RTC_PREDIV_S - 1;
-	hrtc.Init.OutPut = RTC_OUTPUT_DISABLE;
-	hrtc.Init.OutPutPolarity = RTC_OUTPUT_POLARITY_HIGH;
-	hrtc.Init.OutPutType = RTC_OUTPUT_TYPE_OPENDRAIN;
-	
-	// Init RTC
-	HAL_RTC_Init(&hrtc);
-}
-
-// Set RTC by TS
-void RtcSet(const uint32_t now)
-{
-	RTC_TimeTypeDef sTime;
-	RTC_DateTypeDef sDate;
-	struct tm time_tm;
-	time_tm = *localtime((time_t*)&now);
-
-	// Configure time
-	sTime.Hours = (uint8_t)time_tm.tm_hour;
-	sTime.Minutes = (uint8_t)time_tm.tm_min;
-	sTime.Seconds = (uint8_t)time_tm.tm_sec;
-	
-	if (time_tm.tm_wday == 0)
-	{
-		time_tm.tm_wday = 7;
-	}
-
-	// Configure date
-	sDate.WeekDay = (uint8_t)time_tm.tm_wday;
-	sDate.Month = (uint8_t)time_tm.tm_mon + MONTH_EPOCH;
-	sDate.Date = (uint8_t)time_tm.tm_mday;
-	sDate.Year = (uint16_t)(time_tm.tm_year + 1900 - 2000);
-
-	// Set RTC
-	HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-	HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-
-	// Indicate that the RTC now contains a valid time
-	HAL_RTCEx_BKUPWrite(&hrtc, RTC_BKP_DR1, RTC_TIME_GOOD_WORD);
-}
-
-// Get timestamp from RTC
-uint32_t RtcGet(void)
-{
-	RTC_DateTypeDef rtcDate;
-	RTC_TimeTypeDef rtcTime;
-	struct tm tim;
-
-	// Check if the RTC contains a valid time
-	if (HAL_RTCEx_BKUPRead(&hrtc, RTC_BKP_DR1) != RTC_TIME_GOOD_WORD)
-	{
-		return 0;
-	}
-
-	// Get time/date
-	HAL_RTC_GetTime(&hrtc, &rtcTime, RTC_FORMAT_BIN);
-	HAL_RTC_GetDate(&hrtc, &rtcDate, RTC_FORMAT_BIN);
-
-	// Configure the struct
-	tim.tm_year = (uint16_t)(rtcDate.Year + 2000 - 1900);
-	tim.tm_mon  = rtcDate.Month - MONTH_EPOCH;
-	tim.tm_mday = rtcDate.Date;
-	tim.tm_hour = rtcTime.Hours;
-	tim.tm_min  = rtcTime.Minutes;
-	tim.tm_sec  = rtcTime.Seconds;
-
-	return  mktime(&tim);
+#include <stm32f4xx_hal.h>
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include "Clock.h"
+#include "Rtc.h"
+
+// Stolen from:
+// https://community.st.com/thread/46986-unix-epoch-timestamp-to-rtc?commentID=183088
+
+#define RTC_TIME_GOOD_WORD		0x32F2
+
+// Peripheral handles
+static RTC_HandleTypeDef hrtc;
+
+// ~32 Khz clock provided by LSI
+// Small async prescaler so sub seconds have 1mS resolution, the sync one is set from the measured LSI
+#define RTC_PREDIV_A	32
+
+// LSI is only specified to 17-47kHz, and drifts a few percent with temperature
+// So it's measured against HSE at boot, and again from time to time by RtcCalibrate()
+// TIM5 channel 4 can capture LSI internally, every 8th edge, this many times
+#define LSI_CAPTURES	16
+#define LSI_MIN			15000
+#define LSI_MAX			50000
+
+// Register polls for when there's no tick to time out with, tens of ms even at full speed
+#define POLL_LIMIT		200000
+
+static uint32_t lsiFrequency = LSI_VALUE;
+static uint32_t predivS = LSI_VALUE / RTC_PREDIV_A;
+
+// Wakeup timer runs from RTCCLK/16
+#define RTC_WAKEUP_TICKS_PER_SECOND	(lsiFrequency / 16)
+#define RTC_WAKEUP_MAX_MS			(0xffff * 1000UL / RTC_WAKEUP_TICKS_PER_SECOND)
+
+// Unix epoch information
+// STM32 cares about 
+#define MONTH_EPOCH	1
+#define YEAR_EPOCH	(2000 - 1900)
+
+// Returns 0 if the bits never came up
+static uint8_t WaitBits(volatile uint32_t* reg, const uint32_t mask, const uint32_t value)
+{
+	uint32_t i;
+
+	for (i = 0; i < POLL_LIMIT; i++)
+	{
+		if ((*reg & mask) == value)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+// Count timer clocks across a run of LSI edges, the timer runs from the HSE derived APB1
+// Returns 0 if it doesn't come out sensible, or an interrupt made us miss a capture
+static uint32_t MeasureLsi(void)
+{
+	uint32_t first = 0;
+	uint32_t last = 0;
+	uint32_t captures = 0;
+	uint32_t measured;
+
+	__HAL_RCC_TIM5_CLK_ENABLE();
+
+	// Free running 32 bit count, capturing every 8th LSI edge on channel 4
+	TIM5->CR1 = 0;
+	TIM5->PSC = 0;
+	TIM5->ARR = 0xffffffff;
+	TIM5->OR = TIM_OR_TI4_RMP_0;
+	TIM5->CCMR2 = TIM_CCMR2_CC4S_0 | TIM_CCMR2_IC4PSC;
+	TIM5->CCER = TIM_CCER_CC4E;
+	TIM5->EGR = TIM_EGR_UG;
+	TIM5->SR = 0;
+	TIM5->CR1 = TIM_CR1_CEN;
+
+	while (captures <= LSI_CAPTURES && WaitBits(&TIM5->SR, TIM_SR_CC4IF, TIM_SR_CC4IF))
+	{
+		// Reading the capture clears the flag
+		last = TIM5->CCR4;
+
+		// Overwritten before we got to it, the edge count is off
+		if (TIM5->SR & TIM_SR_CC4OF)
+		{
+			break;
+		}
+
+		if (captures == 0)
+		{
+			first = last;
+		}
+
+		captures++;
+	}
+
+	TIM5->CR1 = 0;
+	TIM5->CCER = 0;
+	TIM5->OR = 0;
+	__HAL_RCC_TIM5_CLK_DISABLE();
+
+	if (captures <= LSI_CAPTURES || last == first)
+	{
+		return 0;
+	}
+
+	measured = (uint32_t)((uint64_t)ClockGetApb1TimerFreq() * 8 * LSI_CAPTURES / (last - first));
+
+	return (measured >= LSI_MIN && measured <= LSI_MAX) ? measured : 0;
+}
+
+void RtcInit(void)
+{
+	// Enable clocks
+	__HAL_RCC_RTC_ENABLE();
+
+	// Set the seconds from what LSI actually runs at
+	lsiFrequency = MeasureLsi();
+
+	if (lsiFrequency == 0)
+	{
+		lsiFrequency = LSI_VALUE;
+	}
+
+	predivS = (lsiFrequency + RTC_PREDIV_A / 2) / RTC_PREDIV_A;
+	printf("LSI %luHz\r\n", lsiFrequency);
+
+	// Configure RTC
+	hrtc.Instance = RTC;
+	hrtc.Init.HourFormat = RTC_HOURFORMAT_24;
+	hrtc.Init.AsynchPrediv = RTC_PREDIV_A - 1;
+	hrtc.Init.SynchPrediv = predivS - 1;
+	hrtc.Init.OutPut = RTC_OUTPUT_DISABLE;
+	hrtc.Init.OutPutPolarity = RTC_OUTPUT_POLARITY_HIGH;
+	hrtc.Init.OutPutType = RTC_OUTPUT_TYPE_OPENDRAIN;
+	
+	// Init RTC
+	HAL_RTC_Init(&hrtc);
+
+	// Wakeup timer interrupt, used to leave STOP mode
+	HAL_NVIC_SetPriority(RTC_WKUP_IRQn, 0xf, 0xf);
+	HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+}
+
+// Measure LSI again and keep the calendar seconds and wakeup timer in step with it
+// Takes a few ms, so the caller decides how often
+void RtcCalibrate(void)
+{
+	uint32_t measured;
+	uint32_t prescaler;
+
+	// The timer's clock mustn't change under the measurement
+	ClockLockProfile();
+	measured = MeasureLsi();
+	ClockUnlockProfile();
+
+	if (measured == 0)
+	{
+		return;
+	}
+
+	lsiFrequency = measured;
+	prescaler = (measured + RTC_PREDIV_A / 2) / RTC_PREDIV_A;
+
+	if (prescaler == predivS)
+	{
+		return;
+	}
+
+	// The prescaler can only be written in init mode, which holds the calendar where it is
+	__HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+	hrtc.Instance->ISR = RTC_INIT_MASK;
+
+	if (WaitBits(&hrtc.Instance->ISR, RTC_ISR_INITF, RTC_ISR_INITF))
+	{
+		// Synchronous first, then asynchronous, as two writes
+		hrtc.Instance->PRER = prescaler - 1;
+		hrtc.Instance->PRER |= (RTC_PREDIV_A - 1) << 16;
+		hrtc.Init.SynchPrediv = prescaler - 1;
+		predivS = prescaler;
+	}
+
+	hrtc.Instance->ISR &= ~RTC_ISR_INIT;
+	__HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+}
+
+// Set RTC by TS
+void RtcSet(const uint32_t now)
+{
+	RTC_TimeTypeDef sTime;
+	RTC_DateTypeDef sDate;
+	struct tm time_tm;
+	time_tm = *localtime((time_t*)&now);
+
+	// Configure time
+	sTime.Hours = (uint8_t)time_tm.tm_hour;
+	sTime.Minutes = (uint8_t)time_tm.tm_min;
+	sTime.Seconds = (uint8_t)time_tm.tm_sec;
+	
+	if (time_tm.tm_wday == 0)
+	{
+		time_tm.tm_wday = 7;
+	}
+
+	// Configure date
+	sDate.WeekDay = (uint8_t)time_tm.tm_wday;
+	sDate.Month = (uint8_t)time_tm.tm_mon + MONTH_EPOCH;
+	sDate.Date = (uint8_t)time_tm.tm_mday;
+	sDate.Year = (uint16_t)(time_tm.tm_year + 1900 - 2000);
+
+	// Set RTC
+	HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+	HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
+
+	// Indicate that the RTC now contains a valid time
+	HAL_RTCEx_BKUPWrite(&hrtc, RTC_BKP_DR1, RTC_TIME_GOOD_WORD);
+}
+
+// Get timestamp from RTC
+uint32_t RtcGet(void)
+{
+	RTC_DateTypeDef rtcDate;
+	RTC_TimeTypeDef rtcTime;
+	struct tm tim;
+
+	// Check if the RTC contains a valid time
+	if (HAL_RTCEx_BKUPRead(&hrtc, RTC_BKP_DR1) != RTC_TIME_GOOD_WORD)
+	{
+		return 0;
+	}
+
+	// Get time/date
+	HAL_RTC_GetTime(&hrtc, &rtcTime, RTC_FORMAT_BIN);
+	HAL_RTC_GetDate(&hrtc, &rtcDate, RTC_FORMAT_BIN);
+
+	// Configure the struct
+	tim.tm_year = (uint16_t)(rtcDate.Year + 2000 - 1900);
+	tim.tm_mon  = rtcDate.Month - MONTH_EPOCH;
+	tim.tm_mday = rtcDate.Date;
+	tim.tm_hour = rtcTime.Hours;
+	tim.tm_min  = rtcTime.Minutes;
+	tim.tm_sec  = rtcTime.Seconds;
+
+	return  mktime(&tim);
+}
+
+// Arm the wakeup timer to fire in ms milliseconds
+// Returns the period actually armed, which is clamped to what the timer can count, or 0 if it couldn't be armed
+// Called with the tick stopped, so no HAL calls that time out against it
+uint32_t RtcStartWakeup(uint32_t ms)
+{
+	uint32_t ticks;
+	uint8_t ready;
+
+	if (ms > RTC_WAKEUP_MAX_MS)
+	{
+		ms = RTC_WAKEUP_MAX_MS;
+	}
+
+	ticks = ms * RTC_WAKEUP_TICKS_PER_SECOND / 1000;
+
+	if (ticks == 0)
+	{
+		ticks = 1;
+	}
+
+	__HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+	__HAL_RTC_WAKEUPTIMER_DISABLE(&hrtc);
+
+	// The reload can only be written once the timer has actually stopped
+	ready = WaitBits(&hrtc.Instance->ISR, RTC_ISR_WUTWF, RTC_ISR_WUTWF);
+
+	if (ready)
+	{
+		hrtc.Instance->WUTR = ticks - 1;
+		hrtc.Instance->CR = (hrtc.Instance->CR & ~RTC_CR_WUCKSEL) | RTC_WAKEUPCLOCK_RTCCLK_DIV16;
+		__HAL_RTC_WAKEUPTIMER_CLEAR_FLAG(&hrtc, RTC_FLAG_WUTF);
+		__HAL_RTC_WAKEUPTIMER_EXTI_CLEAR_FLAG();
+		__HAL_RTC_WAKEUPTIMER_EXTI_ENABLE_IT();
+		__HAL_RTC_WAKEUPTIMER_EXTI_ENABLE_RISING_EDGE();
+		__HAL_RTC_WAKEUPTIMER_ENABLE_IT(&hrtc, RTC_IT_WUT);
+		__HAL_RTC_WAKEUPTIMER_ENABLE(&hrtc);
+	}
+
+	__HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+
+	return ready ? ms : 0;
+}
+
+// Nothing to wait for in here, so it's safe with the tick stopped
+void RtcStopWakeup(void)
+{
+	__HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+	__HAL_RTC_WAKEUPTIMER_DISABLE(&hrtc);
+	__HAL_RTC_WAKEUPTIMER_DISABLE_IT(&hrtc, RTC_IT_WUT);
+	__HAL_RTC_WAKEUPTIMER_CLEAR_FLAG(&hrtc, RTC_FLAG_WUTF);
+	__HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+
+	__HAL_RTC_WAKEUPTIMER_EXTI_CLEAR_FLAG();
+}
+
+// Get the milliseconds elapsed in the current day
+// Used to measure how long we were asleep, so it doesn't care about the calendar being valid
+uint32_t RtcGetDayMillis(void)
+{
+	RTC_DateTypeDef rtcDate;
+	RTC_TimeTypeDef rtcTime;
+
+	// The shadow registers are stale after leaving STOP, wait for the next copy
+	// A bounded poll, the tick is stopped. If it never comes the reading is just older
+	__HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+	hrtc.Instance->ISR &= ~(RTC_ISR_RSF | RTC_ISR_INIT);
+	__HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+	WaitBits(&hrtc.Instance->ISR, RTC_ISR_RSF, RTC_ISR_RSF);
+
+	// Date must be read after time to unlock the shadow registers
+	HAL_RTC_GetTime(&hrtc, &rtcTime, RTC_FORMAT_BIN);
+	HAL_RTC_GetDate(&hrtc, &rtcDate, RTC_FORMAT_BIN);
+
+	return ((rtcTime.Hours * 3600UL + rtcTime.Minutes * 60UL + rtcTime.Seconds) * 1000UL)
+		+ (((predivS - 1 - rtcTime.SubSeconds) * 1000UL) / predivS);
+}
+
+// Backup registers live in the RTC domain, they survive resets and STOP as long as VBAT holds
+void RtcBackupWrite(const uint32_t reg, const uint32_t value)
+{
+	HAL_RTCEx_BKUPWrite(&hrtc, reg, value);
+}
+
+uint32_t RtcBackupRead(const uint32_t reg)
+{
+	return HAL_RTCEx_BKUPRead(&hrtc, reg);
+}
+
+void RTC_WKUP_IRQHandler(void)
+{
+	HAL_RTCEx_WakeUpTimerIRQHandler(&hrtc);
 }
\ No newline at end of file
@@ -1,10 +1,16 @@
-#ifndef RTC_H
-#define RTC_H
-
-#include <stdint.h>
-
-void RtcInit(void);
-void RtcSet(const uint32_t now);
-uint32_t RtcGet(void);
-
-#endif // !RTC_H
+#ifndef RTC_H
+#define RTC_H
+
+#include <stdint.h>
+
+void RtcInit(void);
+void RtcCalibrate(void);
+void RtcSet(const uint32_t now);
+uint32_t RtcGet(void);
+uint32_t RtcStartWakeup(uint32_t ms);
+void RtcStopWakeup(void);
+uint32_t RtcGetDayMillis(void);
+void RtcBackupWrite(const uint32_t reg, const uint32_t value);
+uint32_t RtcBackupRead(const uint32_t reg);
+
+#endif // !RTC_H
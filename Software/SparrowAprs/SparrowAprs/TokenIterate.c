@@ -1,54 +1,93 @@
-#include <stdint.h>
-#include  "TokenIterate.h"
-
-/*
-
-	Another idea:
-	Gettokens(str, array of token ptrs, array of lengths)
-
-	
-*/
-
-void TokenIteratorInit(TokenIterateT* t, const uint8_t delim, const uint8_t* ptr, const uint32_t size)
-{
-	t->Buffer = (uint8_t*)ptr;
-	t->Delimiter = delim;
-	t->Size = size;
-	t->Index = 0;
-}
-
-// Go from our current position and get the next token 
-uint8_t TokenIteratorForward(TokenIterateT* t, uint8_t** token, uint32_t* length)
-{
-	uint32_t i = 0;
-	uint32_t tokenStart = t->Index;
-	uint32_t next;
-
-	// Check if we're at the end of the string
-	if (t->Index >= t->Size)
-	{
-		return 0;
-	}
-	
-	// Get the end of this token
-	while (t->Index < t->Size)
-	{
-		if (t->Buffer[t->Index++] == t->Delimiter)
-		{
-			break; 
-		}
-	}
-
-	if (t->Index < t->Size)
-	{
-		*length = t->Index - tokenStart - 1;
-	}
-	else
-	{
-		*length = t->Index - tokenStart;
-	}
-	
-	*token = &t->Buffer[tokenStart];
-	
-	return 1;
-}
\ No newline at end of file
+#include <stdint.h>
+#include <string.h>
+#include  "TokenIterate.h"
+
+static void TokenTableAdd(TokenTableT* t, const uint32_t start, const uint32_t end)
+{
+	// Fields past the end of the table are counted but not stored
+	if (t->Count < TOKEN_MAX_FIELDS)
+	{
+		t->Offset[t->Count] = start;
+		t->Length[t->Count] = end - start;
+	}
+
+	t->Count++;
+}
+
+// Split the whole buffer in one pass, recording where every field starts and how long it is
+// Searches a word at a time, only looking at single bytes in words that hold a delimiter
+// Returns the number of fields found
+uint32_t TokenTableSplit(TokenTableT* t, const uint8_t delim, const uint8_t* ptr, const uint32_t size)
+{
+	const uint32_t pattern = delim * 0x01010101UL;
+	uint32_t word;
+	uint32_t i = 0;
+	uint32_t end;
+	uint32_t start = 0;
+
+	t->Buffer = ptr;
+	t->Count = 0;
+
+	// Offsets are bytes
+	if (size > TOKEN_MAX_SIZE)
+	{
+		return 0;
+	}
+
+	while (i + 4 <= size)
+	{
+		memcpy(&word, ptr + i, 4);
+		word ^= pattern;
+
+		// No zero byte after the XOR means no delimiter in these four
+		if (((word - 0x01010101UL) & ~word & 0x80808080UL) == 0)
+		{
+			i += 4;
+			continue;
+		}
+
+		for (end = i + 4; i < end; i++)
+		{
+			if (ptr[i] == delim)
+			{
+				TokenTableAdd(t, start, i);
+				start = i + 1;
+			}
+		}
+	}
+
+	for (; i < size; i++)
+	{
+		if (ptr[i] == delim)
+		{
+			TokenTableAdd(t, start, i);
+			start = i + 1;
+		}
+	}
+
+	// Whatever is after the last delimiter, even if it's empty
+	TokenTableAdd(t, start, size);
+
+	if (t->Count > TOKEN_MAX_FIELDS)
+	{
+		t->Count = TOKEN_MAX_FIELDS;
+	}
+
+	return t->Count;
+}
+
+// Get field number index
+// Returns 0 if the field is missing or empty
+uint8_t TokenTableGet(const TokenTableT* t, const uint32_t index, const uint8_t** token, uint32_t* length)
+{
+	if (index >= t->Count || t->Length[index] == 0)
+	{
+		*length = 0;
+		return 0;
+	}
+
+	*token = t->Buffer + t->Offset[index];
+	*length = t->Length[index];
+
+	return 1;
+}
@@ -1,17 +1,20 @@
-#ifndef TOKENITERATE_H
-#define TOKENITERATE_H
-
-#include <stdint.h>
-
-typedef struct 
-{
-	uint8_t* Buffer;
-	uint32_t Size;
-	uint8_t Delimiter;
-	uint32_t Index;
-} TokenIterateT;
-
-void TokenIteratorInit(TokenIterateT* t, const uint8_t delim, const uint8_t* ptr, const uint32_t size);
-uint8_t TokenIteratorForward(TokenIterateT* t, uint8_t** token, uint32_t* length);
-
-#endif // !TOKENITERATE_H
+#ifndef TOKENITERATE_H
+#define TOKENITERATE_H
+
+#include <stdint.h>
+
+#define TOKEN_MAX_FIELDS	24
+#define TOKEN_MAX_SIZE		255
+
+typedef struct
+{
+	const uint8_t* Buffer;
+	uint32_t Count;
+	uint8_t Offset[TOKEN_MAX_FIELDS];
+	uint8_t Length[TOKEN_MAX_FIELDS];
+} TokenTableT;
+
+uint32_t TokenTableSplit(TokenTableT* t, const uint8_t delim, const uint8_t* ptr, const uint32_t size);
+uint8_t TokenTableGet(const TokenTableT* t, const uint32_t index, const uint8_t** token, uint32_t* length);
+
+#endif // !TOKENITERATE_H
@@ -1,54 +1,297 @@
-#include <stm32f4xx_hal.h>
-#include <string.h>
-#include "Nmea0183.h"
-#include "Helpers.h"
-
-void UbloxNeoInit(void)
-{
-}
-
-static uint8_t NmeaInsertChecksum(uint8_t* buffer, const uint32_t length)
-{
-	uint8_t checksum = 0;
-	uint32_t i = 1;
-
-	for (; i < length; i++)
-	{
-		// If we are at the end of the checksummed area
-		if (buffer[i] == '*')
-		{
-			i++;
-			break;
-		}
-
-		checksum ^= buffer[i];
-	}
-
-	// Check if we have enough space to insert the checksum
-	if (i + 2 > length)
-	{
-		return 0;
-	}
-
-	// Insert the checksum (high nibble first)
-	buffer[i++] = Int2HexDigit((checksum >> 4) & 0x0f);
-	buffer[i++] = Int2HexDigit(checksum & 0x0f);
-
-	return 1;
-}
-
-// Set the output rate for a sentence
-// UBX-13003221 - R15, page 130
-void UbloxNeoSetOutputRate(const char* msgId, const uint8_t rate)
-{
-	uint8_t configStr[31];
-
-	// Format command
-	sprintf((char*)configStr, "$PUBX,40,%.3s,0,%i,0,0,0,0*XX\r\n", msgId, rate);
-
-	// Checksum
-	NmeaInsertChecksum(configStr, 31);
-
-	// Send
-	HAL_UART_Transmit(Nmea0183GetUartHandle(), configStr, 31, 5000);
-}
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+#include "Nmea0183.h"
+#include "Helpers.h"
+#include "UbloxNeo.h"
+
+// Port settings for the receiver's UART1
+#define UBX_PORT_UART1			1
+#define UBX_PORT_MODE_8N1		0x000008D0
+#define UBX_PROTO_UBX			0x0001
+#define UBX_PROTO_NMEA			0x0002
+
+// Link we want: fast enough that the UART is never the bottleneck, 5Hz solutions
+#define GPS_LINK_BAUD			115200
+#define GPS_NAV_PERIOD			200
+
+// Rates to try when the receiver stops making sense, most likely first
+// After a brownout the receiver is back on its 9600 default
+static const uint32_t candidateBauds[] = { GPS_LINK_BAUD, 9600, 38400, 57600, 19200, 230400, 4800 };
+#define CANDIDATE_BAUD_COUNT	(sizeof(candidateBauds) / sizeof(uint32_t))
+
+// Long enough to catch at least one 1Hz NMEA burst at the default settings
+#define GPS_LINK_PROBE_TIME		1200
+
+// NAV-PVT is 92 bytes on protocol 15+, 84 on older firmware. Everything we use is in the first 84
+#define UBX_NAV_PVT_MIN_LENGTH	84
+
+// NAV-PVT flag bits
+#define UBX_PVT_VALID_DATE		0x01
+#define UBX_PVT_VALID_TIME		0x02
+#define UBX_PVT_GNSS_FIX_OK		0x01
+
+// RXM-PMREQ flags and wakeup sources
+#define UBX_PMREQ_BACKUP		0x02
+#define UBX_PMREQ_FORCE			0x04
+#define UBX_PMREQ_WAKE_UART_RX	0x08
+#define UBX_WAKE_BYTES			8
+
+static uint8_t ubxBuffer[UBX_MAX_PAYLOAD + 8];
+
+// Link recovery, one candidate rate at a time, stepped by the hub so it never stops publishing
+static uint8_t recovering = 0;
+static uint32_t probeIndex;
+static uint32_t probeFrameCount;
+static TickType_t probeStart;
+
+void UbloxNeoInit(void)
+{
+}
+
+static uint8_t NmeaInsertChecksum(uint8_t* buffer, const uint32_t length)
+{
+	uint8_t checksum = 0;
+	uint32_t i = 1;
+
+	for (; i < length; i++)
+	{
+		// If we are at the end of the checksummed area
+		if (buffer[i] == '*')
+		{
+			i++;
+			break;
+		}
+
+		checksum ^= buffer[i];
+	}
+
+	// Check if we have enough space to insert the checksum
+	if (i + 2 > length)
+	{
+		return 0;
+	}
+
+	// Insert the checksum (high nibble first)
+	buffer[i++] = Int2HexDigit((checksum >> 4) & 0x0f);
+	buffer[i++] = Int2HexDigit(checksum & 0x0f);
+
+	return 1;
+}
+
+// Set the output rate for a sentence
+// UBX-13003221 - R15, page 130
+void UbloxNeoSetOutputRate(const char* msgId, const uint8_t rate)
+{
+	uint8_t configStr[31];
+
+	// Format command
+	sprintf((char*)configStr, "$PUBX,40,%.3s,0,%i,0,0,0,0*XX\r\n", msgId, rate);
+
+	// Checksum
+	NmeaInsertChecksum(configStr, 31);
+
+	// Send
+	HAL_UART_Transmit(Nmea0183GetUartHandle(), configStr, 31, 5000);
+}
+
+// Little endian field readers, the payload has no alignment guarantees
+static uint16_t UbxU2(const uint8_t* p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static uint32_t UbxU4(const uint8_t* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void UbxPutU2(uint8_t* p, const uint16_t x)
+{
+	p[0] = x & 0xff;
+	p[1] = x >> 8;
+}
+
+static void UbxPutU4(uint8_t* p, const uint32_t x)
+{
+	UbxPutU2(p, x & 0xffff);
+	UbxPutU2(p + 2, x >> 16);
+}
+
+// Frame and send a UBX packet
+// Fletcher checksum covers class, id, length and payload
+void UbloxNeoSendUbx(const uint8_t msgClass, const uint8_t msgId, const uint8_t* payload, const uint16_t length)
+{
+	uint8_t ckA = 0;
+	uint8_t ckB = 0;
+	uint32_t i;
+
+	if (length > UBX_MAX_PAYLOAD)
+	{
+		return;
+	}
+
+	ubxBuffer[0] = UBX_SYNC_1;
+	ubxBuffer[1] = UBX_SYNC_2;
+	ubxBuffer[2] = msgClass;
+	ubxBuffer[3] = msgId;
+	UbxPutU2(ubxBuffer + 4, length);
+	memcpy(ubxBuffer + 6, payload, length);
+
+	for (i = 2; i < length + 6; i++)
+	{
+		ckA += ubxBuffer[i];
+		ckB += ckA;
+	}
+
+	ubxBuffer[length + 6] = ckA;
+	ubxBuffer[length + 7] = ckB;
+
+	HAL_UART_Transmit(Nmea0183GetUartHandle(), ubxBuffer, length + 8, 5000);
+}
+
+// Switch the receiver over to 5Hz binary NAV-PVT only, at our link baud rate
+// Must be called at whatever baud rate the receiver is currently using
+// UBX-13003221 - R15, CFG-MSG page 182, CFG-PRT page 197, CFG-RATE page 215
+void UbloxNeoConfigure(void)
+{
+	uint8_t payload[20];
+
+	// NAV-PVT on every navigation solution
+	payload[0] = UBX_CLASS_NAV;
+	payload[1] = UBX_ID_NAV_PVT;
+	payload[2] = 1;
+	UbloxNeoSendUbx(UBX_CLASS_CFG, UBX_ID_CFG_MSG, payload, 3);
+
+	// Solution rate, one navigation solution per measurement, aligned to GPS time
+	UbxPutU2(payload + 0, GPS_NAV_PERIOD);
+	UbxPutU2(payload + 2, 1);
+	UbxPutU2(payload + 4, 1);
+	UbloxNeoSendUbx(UBX_CLASS_CFG, UBX_ID_CFG_RATE, payload, 6);
+
+	// Still accept NMEA in (for PUBX), but only send UBX out
+	memset(payload, 0, sizeof(payload));
+	payload[0] = UBX_PORT_UART1;
+	UbxPutU4(payload + 4, UBX_PORT_MODE_8N1);
+	UbxPutU4(payload + 8, GPS_LINK_BAUD);
+	UbxPutU2(payload + 12, UBX_PROTO_UBX | UBX_PROTO_NMEA);
+	UbxPutU2(payload + 14, UBX_PROTO_UBX);
+	UbloxNeoSendUbx(UBX_CLASS_CFG, UBX_ID_CFG_PRT, payload, 20);
+
+	// The receiver switches as soon as it has the port config, follow it
+	Nmea0183SetBaudRate(GPS_LINK_BAUD);
+}
+
+static void StartProbe(void)
+{
+	Nmea0183SetBaudRate(candidateBauds[probeIndex]);
+	probeFrameCount = Nmea0183GetFrameCount();
+	probeStart = xTaskGetTickCount();
+}
+
+// Start looking for the receiver again after it has lost its configuration (brownout, reset)
+// Listens at each candidate rate for a valid frame, then re-applies our settings at that rate
+void UbloxNeoStartRecovery(void)
+{
+	recovering = 1;
+	probeIndex = 0;
+	StartProbe();
+}
+
+uint8_t UbloxNeoIsRecovering(void)
+{
+	return recovering;
+}
+
+// Call every so often while recovering, it never blocks
+// Returns 1 when recovery has finished, found or not
+uint8_t UbloxNeoServiceRecovery(void)
+{
+	if (!recovering)
+	{
+		return 0;
+	}
+
+	if (Nmea0183GetFrameCount() != probeFrameCount)
+	{
+		printf("GPS found at %lu\r\n", candidateBauds[probeIndex]);
+		UbloxNeoConfigure();
+		recovering = 0;
+		return 1;
+	}
+
+	if (xTaskGetTickCount() - probeStart < GPS_LINK_PROBE_TIME / portTICK_PERIOD_MS)
+	{
+		return 0;
+	}
+
+	if (++probeIndex < CANDIDATE_BAUD_COUNT)
+	{
+		StartProbe();
+		return 0;
+	}
+
+	// Nothing, leave it where we want it to be and try again later
+	Nmea0183SetBaudRate(GPS_LINK_BAUD);
+	recovering = 0;
+
+	return 1;
+}
+
+// Put the receiver into software backup for ms milliseconds
+// It keeps ephemeris and config in battery backed RAM, so it comes back with a hot start
+// Any traffic on its UART RX wakes it early
+// UBX-13003221 - R15, RXM-PMREQ page 290
+void UbloxNeoSleep(const uint32_t ms)
+{
+	uint8_t payload[16];
+
+	memset(payload, 0, sizeof(payload));
+	UbxPutU4(payload + 4, ms);
+	UbxPutU4(payload + 8, UBX_PMREQ_BACKUP | UBX_PMREQ_FORCE);
+	UbxPutU4(payload + 12, UBX_PMREQ_WAKE_UART_RX);
+	UbloxNeoSendUbx(UBX_CLASS_RXM, UBX_ID_RXM_PMREQ, payload, sizeof(payload));
+}
+
+// Wake the receiver before its backup period is up
+// The first bytes are lost while it starts, so they're just padding
+void UbloxNeoWake(void)
+{
+	uint8_t wake[UBX_WAKE_BYTES];
+
+	memset(wake, 0xff, sizeof(wake));
+	HAL_UART_Transmit(Nmea0183GetUartHandle(), wake, sizeof(wake), 100);
+}
+
+// Decode a NAV-PVT payload
+// Lat/Lon 1e-7 deg, altitude mm, speeds mm/s, heading 1e-5 deg, PDOP 0.01
+uint8_t UbloxNeoParseNavPvt(const uint8_t* payload, const uint32_t length, UbxNavPvtT* pvt)
+{
+	if (length < UBX_NAV_PVT_MIN_LENGTH)
+	{
+		return 0;
+	}
+
+	pvt->ITow = UbxU4(payload + 0);
+	pvt->Year = UbxU2(payload + 4);
+	pvt->Month = payload[6];
+	pvt->Day = payload[7];
+	pvt->Hour = payload[8];
+	pvt->Minute = payload[9];
+	pvt->Second = payload[10];
+	pvt->TimeValid = ((payload[11] & (UBX_PVT_VALID_DATE | UBX_PVT_VALID_TIME)) == (UBX_PVT_VALID_DATE | UBX_PVT_VALID_TIME));
+	pvt->FixType = payload[20];
+	pvt->FixOk = (payload[21] & UBX_PVT_GNSS_FIX_OK) ? 1 : 0;
+	pvt->SatCount = payload[23];
+	pvt->Lon = (int32_t)UbxU4(payload + 24);
+	pvt->Lat = (int32_t)UbxU4(payload + 28);
+	pvt->AltitudeMsl = (int32_t)UbxU4(payload + 36);
+	pvt->VelocityDown = (int32_t)UbxU4(payload + 56);
+	pvt->GroundSpeed = (int32_t)UbxU4(payload + 60);
+	pvt->Heading = (int32_t)UbxU4(payload + 64);
+	pvt->PDop = UbxU2(payload + 76);
+
+	return 1;
+}
\ No newline at end of file
@@ -1,7 +1,34 @@
-#ifndef UBLOXNEO_H
-#define UBLOXNEO_H
-
-void UbloxNeoSetOutputRate(const char* msgId, const uint8_t rate);
-
-
-#endif // !UBLOXNEO_H
+#ifndef UBLOXNEO_H
+#define UBLOXNEO_H
+
+#include <stdint.h>
+#include "Nmea0183.h"
+
+#define UBX_SYNC_1				0xB5
+#define UBX_SYNC_2				0x62
+#define UBX_HEADER_SIZE			4
+#define UBX_MAX_PAYLOAD			176
+
+#define UBX_CLASS_NAV			0x01
+#define UBX_CLASS_CFG			0x06
+#define UBX_CLASS_RXM			0x02
+#define UBX_CLASS_MGA			0x13
+#define UBX_ID_NAV_PVT			0x07
+#define UBX_ID_CFG_PRT			0x00
+#define UBX_ID_CFG_MSG			0x01
+#define UBX_ID_CFG_RATE			0x08
+#define UBX_ID_RXM_PMREQ		0x41
+#define UBX_ID_MGA_INI			0x40
+#define UBX_ID_MGA_DBD			0x80
+
+void UbloxNeoSetOutputRate(const char* msgId, const uint8_t rate);
+void UbloxNeoSendUbx(const uint8_t msgClass, const uint8_t msgId, const uint8_t* payload, const uint16_t length);
+void UbloxNeoConfigure(void);
+void UbloxNeoStartRecovery(void);
+uint8_t UbloxNeoIsRecovering(void);
+uint8_t UbloxNeoServiceRecovery(void);
+void UbloxNeoSleep(const uint32_t ms);
+void UbloxNeoWake(void);
+uint8_t UbloxNeoParseNavPvt(const uint8_t* payload, const uint32_t length, UbxNavPvtT* pvt);
+
+#endif // !UBLOXNEO_H
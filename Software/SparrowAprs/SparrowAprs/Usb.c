@@ -1,22 +1,85 @@
-#include <stm32f4xx_hal.h>
-#include "Usb/usbd_desc.h"
-#include "Usb/usbd_cdc.h"
-#include "Usb/usbd_core.h"
-#include "Usb/usbd_cdc_if.h"
-#include "Usb/usbd_def.h"
-
-extern USBD_HandleTypeDef USBD_Device;
-extern PCD_HandleTypeDef hpcd;
-
-void UsbInit(void)
-{
-	USBD_Init(&USBD_Device, &VCP_Desc, 0);
-	USBD_RegisterClass(&USBD_Device, USBD_CDC_CLASS);
-	USBD_CDC_RegisterInterface(&USBD_Device, &USBD_CDC_Template_fops);
-	USBD_Start(&USBD_Device);
-}
-
-void OTG_FS_IRQHandler(void)
-{
-	HAL_PCD_IRQHandler(&hpcd);
+#include <stm32f4xx_hal.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "Usb/usbd_desc.h"
+#include "Usb/usbd_cdc.h"
+#include "Usb/usbd_core.h"
+#include "Usb/usbd_cdc_if.h"
+#include "Usb/usbd_def.h"
+
+extern USBD_HandleTypeDef USBD_Device;
+extern PCD_HandleTypeDef hpcd;
+
+// Give up on a host that stops taking data after this many ms per packet
+#define USB_TX_TIMEOUT		500
+
+static uint8_t txBuffer[CDC_DATA_FS_MAX_PACKET_SIZE];
+static SemaphoreHandle_t txMutex;
+
+void UsbInit(void)
+{
+	txMutex = xSemaphoreCreateMutex();
+
+	USBD_Init(&USBD_Device, &VCP_Desc, 0);
+	USBD_RegisterClass(&USBD_Device, USBD_CDC_CLASS);
+	USBD_CDC_RegisterInterface(&USBD_Device, &USBD_CDC_Template_fops);
+	USBD_Start(&USBD_Device);
+}
+
+// Send to the host from a task, one packet at a time
+// Blocks until it's all been handed to the USB core
+// Returns 0 if nobody is connected or they stop listening
+uint8_t UsbTransmit(const uint8_t* data, uint32_t length)
+{
+	USBD_CDC_HandleTypeDef* cdc;
+	uint32_t chunk;
+	uint32_t waited;
+	uint8_t result = 1;
+
+	xSemaphoreTake(txMutex, portMAX_DELAY);
+
+	while (length > 0)
+	{
+		cdc = (USBD_CDC_HandleTypeDef*)USBD_Device.pClassData;
+
+		if (USBD_Device.dev_state != USBD_STATE_CONFIGURED || cdc == NULL)
+		{
+			result = 0;
+			break;
+		}
+
+		// The buffer is ours again once the last packet has gone
+		waited = 0;
+
+		while (cdc->TxState != 0 && waited < USB_TX_TIMEOUT)
+		{
+			vTaskDelay(1);
+			waited++;
+		}
+
+		if (cdc->TxState != 0)
+		{
+			result = 0;
+			break;
+		}
+
+		chunk = (length > sizeof(txBuffer)) ? sizeof(txBuffer) : length;
+		memcpy(txBuffer, data, chunk);
+		USBD_CDC_SetTxBuffer(&USBD_Device, txBuffer, chunk);
+		USBD_CDC_TransmitPacket(&USBD_Device);
+
+		data += chunk;
+		length -= chunk;
+	}
+
+	xSemaphoreGive(txMutex);
+
+	return result;
+}
+
+void OTG_FS_IRQHandler(void)
+{
+	HAL_PCD_IRQHandler(&hpcd);
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
-#ifndef __USBD_CDC_IF_TEMPLATE_H
-#define __USBD_CDC_IF_TEMPLATE_H
-
-#include "usbd_cdc.h"
-
-extern USBD_CDC_ItfTypeDef  USBD_CDC_Template_fops;
-
-#endif
-
-
+#ifndef __USBD_CDC_IF_TEMPLATE_H
+#define __USBD_CDC_IF_TEMPLATE_H
+
+#include "usbd_cdc.h"
+
+extern USBD_CDC_ItfTypeDef  USBD_CDC_Template_fops;
+
+#endif
+
+
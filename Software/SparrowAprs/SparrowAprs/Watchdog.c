@@ -1,17 +1,56 @@
-#include <stm32f4xx_hal.h>
-
-static IWDG_HandleTypeDef watchdogHandle;
-
-void WatchdogInit(void)
-{
-	// Init watchdog
-	watchdogHandle.Init.Prescaler = IWDG_PRESCALER_16;
-	watchdogHandle.Init.Reload = 0x0fff;
-	watchdogHandle.Instance = IWDG;
-	HAL_IWDG_Init(&watchdogHandle);
-}
-
-void WatchdogFeed(void)
-{
-	__HAL_IWDG_RELOAD_COUNTER(&watchdogHandle);
-}
+#include <stm32f4xx_hal.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "Crash.h"
+#include "Watchdog.h"
+
+// LSI / 64 with the full reload is ~8s, no less than 5.5s with the LSI at its fastest
+// Long enough for a sector erase to stall the feeder and not bite
+#define WATCHDOG_PRESCALER		IWDG_PRESCALER_64
+#define WATCHDOG_RELOAD			0x0fff
+
+// Not fed for this long and it's about to bite, get the crash record down first
+#define WATCHDOG_WARNING		4000
+
+static IWDG_HandleTypeDef watchdogHandle;
+static volatile TickType_t lastFeed = 0;
+static uint8_t warned = 0;
+
+void WatchdogInit(void)
+{
+	// Init watchdog
+	watchdogHandle.Init.Prescaler = WATCHDOG_PRESCALER;
+	watchdogHandle.Init.Reload = WATCHDOG_RELOAD;
+	watchdogHandle.Instance = IWDG;
+	HAL_IWDG_Init(&watchdogHandle);
+}
+
+void WatchdogFeed(void)
+{
+	__HAL_IWDG_RELOAD_COUNTER(&watchdogHandle);
+
+	// Before the scheduler the tick isn't running and nothing's checking
+	if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+	{
+		lastFeed = xTaskGetTickCount();
+	}
+
+	// A warning that came to nothing, watch for the next one
+	if (warned)
+	{
+		CrashWatchdogRecovered();
+		warned = 0;
+	}
+}
+
+// Called from the tick interrupt
+// The feeder is the lowest priority task there is, if it's starved something is hogging the CPU
+void WatchdogCheck(void)
+{
+	if (!warned && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING
+		&& xTaskGetTickCountFromISR() - lastFeed > WATCHDOG_WARNING)
+	{
+		warned = 1;
+		CrashWatchdogWarning();
+	}
+}
@@ -1,7 +1,8 @@
-#ifndef WATCHDOG_H
-#define WATCHDOG_H
-
-void WatchdogInit(void);
-void WatchdogFeed(void);
-
-#endif // !WATCHDOG_H
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+void WatchdogInit(void);
+void WatchdogFeed(void);
+void WatchdogCheck(void);
+
+#endif // !WATCHDOG_H